@@ -31,7 +31,8 @@
 
 /*
  * Compares the performance of different multiplication methods in BFV
- * using EvalMultMany operation.
+ * using EvalMultMany operation, and the speedup of a single EvalMult
+ * (tensor product and scaling) on all machine threads over one thread.
  */
 
 #define PROFILE
@@ -63,6 +64,16 @@ static void MultBFVArguments(benchmark::internal::Benchmark* b) {
     }
 }
 
+static void MultBFVThreadArguments(benchmark::internal::Benchmark* b) {
+    int machineThreads = OpenFHEParallelControls.GetMachineThreads();
+    b->ArgNames({"mult_method", "threads"});
+    for (MultiplicationTechnique multMethod : MULT_METHOD_ARGS) {
+        b->Args({multMethod, 1})->MinTime(10);
+        if (machineThreads > 1)
+            b->Args({multMethod, machineThreads})->MinTime(10);
+    }
+}
+
 /*
  * Context setup utility methods
  */
@@ -125,4 +136,26 @@ void BFVrns_EvalMult(benchmark::State& state) {
 }
 BENCHMARK(BFVrns_EvalMult)->Unit(benchmark::kMillisecond)->Apply(MultBFVArguments);
 
+void BFVrns_EvalMultNoRelin(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateBFVrnsContext(MULT_METHOD_ARGS[state.range(0) - 1]);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+
+    std::vector<int64_t> vectorOfInts = {1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0, 1};
+    Plaintext plaintext               = cc->MakeCoefPackedPlaintext(vectorOfInts);
+
+    auto ciphertext1 = cc->Encrypt(keyPair.publicKey, plaintext);
+    auto ciphertext2 = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    OpenFHEParallelControls.SetNumThreads(state.range(1));
+
+    Ciphertext<DCRTPoly> ciphertextMult;
+    while (state.KeepRunning()) {
+        ciphertextMult = cc->EvalMultNoRelin(ciphertext1, ciphertext2);
+    }
+
+    OpenFHEParallelControls.SetNumThreads(OpenFHEParallelControls.GetMachineThreads());
+}
+BENCHMARK(BFVrns_EvalMultNoRelin)->Unit(benchmark::kMillisecond)->Apply(MultBFVThreadArguments);
+
 BENCHMARK_MAIN();
@@ -121,4 +121,85 @@ void CKKS_serialize(benchmark::State& state) {
 
 BENCHMARK(CKKS_serialize)->Unit(benchmark::kMicrosecond)->MinTime(10.0);
 
+// a product rescaled once, as returned to a client, and the relinearization key
+struct CKKSSerializeFixture {
+    CKKSSerializeFixture() {
+        CCParams<CryptoContextCKKSRNS> parameters;
+        parameters.SetRingDim(1 << 14);
+        parameters.SetMultiplicativeDepth(10);
+        parameters.SetScalingModSize(50);
+        parameters.SetSecurityLevel(HEStd_NotSet);
+
+        cc = GenCryptoContext(parameters);
+        cc->Enable(PKE);
+        cc->Enable(KEYSWITCH);
+        cc->Enable(LEVELEDSHE);
+
+        auto kp = cc->KeyGen();
+        cc->EvalMultKeyGen(kp.secretKey);
+        evalKey = cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0];
+
+        std::vector<double> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+        auto ct                  = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vals));
+        ciphertext               = cc->Rescale(cc->EvalMult(ct, ct));
+    }
+
+    CryptoContext<DCRTPoly> cc;
+    EvalKey<DCRTPoly> evalKey;
+    Ciphertext<DCRTPoly> ciphertext;
+};
+
+static CKKSSerializeFixture& GetFixture() {
+    static CKKSSerializeFixture fixture;
+    return fixture;
+}
+
+void CKKS_serializeCiphertextBinary(benchmark::State& state) {
+    auto& f = GetFixture();
+    Ciphertext<DCRTPoly> newC;
+    std::stringstream s;
+    while (state.KeepRunning()) {
+        Serial::Serialize(f.ciphertext, s, SerType::BINARY);
+        Serial::Deserialize(newC, s, SerType::BINARY);
+    }
+}
+
+BENCHMARK(CKKS_serializeCiphertextBinary)->Unit(benchmark::kMicrosecond);
+
+void CKKS_serializeCiphertextFlat(benchmark::State& state) {
+    auto& f = GetFixture();
+    Ciphertext<DCRTPoly> newC;
+    std::stringstream s;
+    while (state.KeepRunning()) {
+        f.cc->SerializeFlat(f.ciphertext, s);
+        newC = f.cc->DeserializeCiphertextFlat(s);
+    }
+}
+
+BENCHMARK(CKKS_serializeCiphertextFlat)->Unit(benchmark::kMicrosecond);
+
+void CKKS_serializeEvalKeyBinary(benchmark::State& state) {
+    auto& f = GetFixture();
+    EvalKey<DCRTPoly> newKey;
+    std::stringstream s;
+    while (state.KeepRunning()) {
+        Serial::Serialize(f.evalKey, s, SerType::BINARY);
+        Serial::Deserialize(newKey, s, SerType::BINARY);
+    }
+}
+
+BENCHMARK(CKKS_serializeEvalKeyBinary)->Unit(benchmark::kMicrosecond);
+
+void CKKS_serializeEvalKeyFlat(benchmark::State& state) {
+    auto& f = GetFixture();
+    EvalKey<DCRTPoly> newKey;
+    std::stringstream s;
+    while (state.KeepRunning()) {
+        f.cc->SerializeFlat(f.evalKey, s);
+        newKey = f.cc->DeserializeEvalKeyFlat(s);
+    }
+}
+
+BENCHMARK(CKKS_serializeEvalKeyFlat)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
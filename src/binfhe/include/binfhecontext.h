@@ -40,6 +40,7 @@
 
 #include "utils/serializable.h"
 #include "lattice/stdlatticeparms.h"
+#include "utils/opcounters.h"
 
 #include <memory>
 #include <string>
@@ -291,6 +292,52 @@ public:
    */
     LWECiphertext EvalConstant(bool value) const;
 
+    /**
+   * Reports the memory held by the bootstrapping keys of this context, in bytes, by category:
+   * "RefreshKey" and "SwitchingKey" (the keys loaded by BTKeyGen/BTKeyLoad) and "BTKeyMap"
+   * (the per-base keys used for arbitrary function evaluation)
+   *
+   * @return map from category to the number of bytes
+   */
+    std::map<std::string, size_t> GetMemoryUsage() const {
+        size_t btKeyMap = 0;
+        for (const auto& entry : m_BTKey_map) {
+            if (entry.second.BSkey)
+                btKeyMap += entry.second.BSkey->GetMemoryUsage();
+            if (entry.second.KSkey)
+                btKeyMap += entry.second.KSkey->GetMemoryUsage();
+        }
+        return {{"RefreshKey", m_BTKey.BSkey ? m_BTKey.BSkey->GetMemoryUsage() : 0},
+                {"SwitchingKey", m_BTKey.KSkey ? m_BTKey.KSkey->GetMemoryUsage() : 0},
+                {"BTKeyMap", btKeyMap}};
+    }
+
+    /**
+   * Returns the hot-path operation counters (and timers, if enabled) summed over all threads.
+   * The counters are process-wide, so the snapshot covers all contexts.
+   *
+   * @return snapshot of the counters; use ToJSON() to export it
+   */
+    static OpCounterSnapshot GetOpCounters() {
+        return OpCounters::GetSnapshot();
+    }
+
+    /**
+   * Resets the hot-path operation counters and timers of all threads
+   */
+    static void ResetOpCounters() {
+        OpCounters::Reset();
+    }
+
+    /**
+   * Turns the scoped timers of the hot-path operations on or off (they are off by default)
+   *
+   * @param enable true to collect timing information
+   */
+    static void EnableOpTimers(bool enable = true) {
+        OpCounters::EnableTimers(enable);
+    }
+
     const std::shared_ptr<BinFHECryptoParams> GetParams() {
         return m_params;
     }
@@ -34,8 +34,11 @@
 
 #include "lwe-ciphertext-fwd.h"
 #include "math/hal.h"
+#include "utils/flatserial.h"
 #include "utils/serializable.h"
 
+#include <istream>
+#include <ostream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -109,6 +112,13 @@ public:
         return m_a.GetLength();
     }
 
+    /**
+   * @return the number of bytes held by the ciphertext
+   */
+    size_t GetMemoryUsage() const {
+        return sizeof(*this) + m_a.GetLength() * sizeof(NativeInteger);
+    }
+
     void SetA(const NativeVector& a) {
         m_a = a;
     }
@@ -131,6 +141,38 @@ public:
         return !(*this == other);
     }
 
+    /**
+   * Writes the ciphertext in the flat binary format: a header with the length and the modulus, then b and the
+   * raw array of a
+   * @param os the output stream
+   */
+    void SerializeFlat(std::ostream& os) const {
+        const uint32_t n = m_a.GetLength();
+        Serial::WriteFlat(os, Serial::FLAT_TAG_LWE);
+        Serial::WriteFlat(os, static_cast<uint32_t>(1));
+        Serial::WriteFlat(os, n);
+        Serial::WriteFlat(os, static_cast<uint32_t>(sizeof(NativeInteger)));
+        Serial::WriteFlat(os, m_a.GetModulus());
+        Serial::WriteFlat(os, m_b);
+        Serial::WriteFlat(os, m_a.data(), n);
+    }
+
+    /**
+   * Reads a ciphertext written by SerializeFlat
+   * @param is the input stream
+   */
+    void DeserializeFlat(std::istream& is) {
+        Serial::CheckFlatTag(is, Serial::FLAT_TAG_LWE, "LWECiphertext");
+        const auto version = Serial::ReadFlat<uint32_t>(is);
+        const auto n       = Serial::ReadFlat<uint32_t>(is);
+        if (version > 1 || Serial::ReadFlat<uint32_t>(is) != sizeof(NativeInteger))
+            OPENFHE_THROW(deserialize_error, "the flat LWECiphertext was written by another version of the library");
+        const auto modulus = Serial::ReadFlat<NativeInteger>(is);
+        m_b                = Serial::ReadFlat<NativeInteger>(is);
+        m_a                = NativeVector(n, modulus);
+        Serial::ReadFlat(is, m_a.data(), n);
+    }
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("a", m_a));
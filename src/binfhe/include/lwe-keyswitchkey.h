@@ -92,6 +92,24 @@ public:
         m_keyB = keyB;
     }
 
+    /**
+   * @return the number of bytes held by the key vectors
+   */
+    size_t GetMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& l1 : m_keyA) {
+            for (const auto& l2 : l1) {
+                for (const auto& vec : l2)
+                    bytes += sizeof(vec) + vec.GetLength() * sizeof(NativeInteger);
+            }
+        }
+        for (const auto& l1 : m_keyB) {
+            for (const auto& l2 : l1)
+                bytes += l2.size() * sizeof(NativeInteger);
+        }
+        return bytes;
+    }
+
     bool operator==(const LWESwitchingKeyImpl& other) const {
         return (m_keyA == other.m_keyA && m_keyB == other.m_keyB);
     }
@@ -105,6 +105,22 @@ public:
         m_key = key;
     }
 
+    /**
+   * @return the number of bytes held by all RingGSW evaluation keys of the accumulator key
+   */
+    size_t GetMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& l1 : m_key) {
+            for (const auto& l2 : l1) {
+                for (const auto& key : l2) {
+                    if (key)
+                        bytes += key->GetMemoryUsage();
+                }
+            }
+        }
+        return bytes;
+    }
+
     std::vector<std::vector<RingGSWEvalKey>>& operator[](uint32_t i) {
         return m_key[i];
     }
@@ -100,6 +100,18 @@ public:
         m_elements = elements;
     }
 
+    /**
+   * @return the number of bytes held by the key polynomials
+   */
+    size_t GetMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& row : m_elements) {
+            for (const auto& poly : row)
+                bytes += poly.GetMemoryUsage();
+        }
+        return bytes;
+    }
+
     /**
    * Switches between COEFFICIENT and Format::EVALUATION polynomial
    * representations using NTT
@@ -31,6 +31,8 @@
 
 #include "rgsw-acc-cggi.h"
 
+#include "utils/opcounters.h"
+
 #include <string>
 #include <iostream>
 #include <iomanip>
@@ -81,6 +83,7 @@ RingGSWACCKey RingGSWAccumulatorCGGI::KeyGenAcc(const std::shared_ptr<RingGSWCry
 
 void RingGSWAccumulatorCGGI::EvalAcc(const std::shared_ptr<RingGSWCryptoParams> params, const RingGSWACCKey ek,
                                      RLWECiphertext& acc, const NativeVector& a) const {
+    OpCounterScope opCount(OPCOUNT_EVALACC);
     auto mod        = a.GetModulus();
     uint32_t n      = a.GetLength();
     uint32_t M      = 2 * params->GetN();
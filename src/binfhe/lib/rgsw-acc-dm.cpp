@@ -31,6 +31,8 @@
 
 #include "rgsw-acc-dm.h"
 
+#include "utils/opcounters.h"
+
 #include <string>
 
 namespace lbcrypto {
@@ -67,6 +69,7 @@ RingGSWACCKey RingGSWAccumulatorDM::KeyGenAcc(const std::shared_ptr<RingGSWCrypt
 
 void RingGSWAccumulatorDM::EvalAcc(const std::shared_ptr<RingGSWCryptoParams> params, const RingGSWACCKey ek,
                                    RLWECiphertext& acc, const NativeVector& a) const {
+    OpCounterScope opCount(OPCOUNT_EVALACC);
     uint32_t baseR = params->GetBaseR();
     auto digitsR   = params->GetDigitsR();
     auto q         = params->Getq();
@@ -137,3 +137,24 @@ TEST(UnitTestFHEWSerialGINX, BINARY) {
     UnitTestFHEWSerial(SerType::BINARY, TOY, GINX, FRESH, msg);
 }
 
+
+TEST(UnitTestFHEWSerialFlat, LWECiphertext) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, AP);
+    auto sk = cc.KeyGen();
+
+    for (LWEPlaintext val : {0, 1}) {
+        auto ct = cc.Encrypt(sk, val, FRESH);
+
+        std::stringstream s;
+        ct->SerializeFlat(s);
+        auto loaded = std::make_shared<LWECiphertextImpl>();
+        loaded->DeserializeFlat(s);
+        EXPECT_EQ(*ct, *loaded) << "Flat LWE ciphertext does not round trip";
+        EXPECT_EQ(loaded->GetModulus(), ct->GetModulus());
+
+        LWEPlaintext result;
+        cc.Decrypt(sk, loaded, &result);
+        EXPECT_EQ(val, result) << "Decryption of a flat LWE ciphertext fails";
+    }
+}
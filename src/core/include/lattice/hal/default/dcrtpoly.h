@@ -46,6 +46,8 @@
 
 #include "utils/inttypes.h"
 #include "utils/exception.h"
+#include "utils/opcounters.h"
+#include "utils/flatserial.h"
 
 #include "lattice/ildcrtparams.h"
 #include "lattice/hal/dcrtpoly-interface.h"
@@ -170,6 +172,18 @@ public:
    */
     DCRTPolyImpl(DugType& dug, const std::shared_ptr<Params> params, Format format = EVALUATION);
 
+    /**
+   * @brief Constructor for a uniformly random polynomial that is reproducible
+   * from a seed. The values are sampled directly in the given format; tower i
+   * is drawn from a PRNG seeded with seed, its last word replaced by i, so the
+   * last word of seed is ignored.
+   *
+   * @param seed the PRNG seed.
+   * @param params the input params.
+   * @param format the input format.
+   */
+    DCRTPolyImpl(const PRNGSeed& seed, const std::shared_ptr<Params> params, Format format = EVALUATION);
+
     /**
    * @brief Construct using a single Poly. The Poly is copied into every tower.
    * Each tower will be reduced to it's corresponding modulus  via GetModuli(at
@@ -465,6 +479,7 @@ public:
    * @return is the result of the automorphism transform.
    */
     DCRTPolyType AutomorphismTransform(const usint& i) const override {
+        OpCounterScope opCount(OPCOUNT_AUTOMORPHISM);
         DCRTPolyType result(*this);
         for (usint k = 0; k < m_vectors.size(); k++) {
             result.m_vectors[k] = m_vectors[k].AutomorphismTransform(i);
@@ -481,6 +496,7 @@ public:
    * @return is the result of the automorphism transform.
    */
     DCRTPolyType AutomorphismTransform(usint i, const std::vector<usint>& vec) const override {
+        OpCounterScope opCount(OPCOUNT_AUTOMORPHISM);
         DCRTPolyType result(*this);
         for (usint k = 0; k < m_vectors.size(); k++) {
             result.m_vectors[k] = m_vectors[k].AutomorphismTransform(i, vec);
@@ -735,6 +751,19 @@ public:
    */
     bool IsEmpty() const override;
 
+    /**
+   * @brief Returns the number of bytes owned by the element: the object itself and the
+   * coefficient vectors of all towers. The shared parameters are not included.
+   *
+   * @return memory usage in bytes
+   */
+    size_t GetMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& tower : m_vectors)
+            bytes += tower.GetMemoryUsage();
+        return bytes;
+    }
+
     /**
    * @brief Drops the last element in the double-CRT representation. The
    * resulting DCRTPoly element will have one less tower.
@@ -1336,6 +1365,30 @@ public:
    */
     double Norm() const override;
 
+    /**
+   * @brief Writes the element in the flat binary format: a header with the ring
+   * dimension, the number of towers, the format and the tower moduli, followed
+   * by the coefficients of every tower as one raw array of native words. The
+   * parameters themselves are not written. With bitPacked, the coefficients
+   * of each tower are packed to the bit width of its modulus instead.
+   *
+   * @param os the output stream.
+   * @param bitPacked true to pack the coefficients to the modulus width.
+   */
+    void SerializeFlat(std::ostream& os, bool bitPacked = false) const;
+
+    /**
+   * @brief Reads an element written by SerializeFlat. Each tower takes its
+   * parameters from the tower of params with the same modulus, so params have
+   * to come from a context with the same parameters; it is reused as is when
+   * the towers match it exactly. The coefficients are read straight into the
+   * tower vectors, or unpacked into them if they were bit-packed.
+   *
+   * @param is the input stream.
+   * @param params parameters covering all towers of the stored element.
+   */
+    void DeserializeFlat(std::istream& is, const std::shared_ptr<Params>& params);
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("v", m_vectors));
@@ -726,6 +726,19 @@ public:
    */
     bool IsEmpty() const;
 
+    /**
+   * @brief Returns the number of bytes owned by the element: the object itself and its
+   * coefficient vector. The shared parameters are not included.
+   *
+   * @return memory usage in bytes
+   */
+    size_t GetMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        if (m_values != nullptr)
+            bytes += sizeof(VecType) + m_values->GetLength() * sizeof(Integer);
+        return bytes;
+    }
+
     /**
    * @brief Determines if inverse exists
    *
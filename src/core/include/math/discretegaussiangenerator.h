@@ -80,6 +80,11 @@ namespace lbcrypto {
 
 const double KARNEY_THRESHOLD = 300;
 
+// CDF tables with at most this many entries are searched by a full scan that
+// does not depend on the sample (sigma = 3.2 gives 39 entries); larger tables
+// fall back to binary search
+const usint CDT_SCAN_THRESHOLD = 64;
+
 template <typename VecType>
 class DiscreteGaussianGeneratorImpl;
 
@@ -203,6 +208,22 @@ public:
 private:
     usint FindInVector(const std::vector<double>& S, double search) const;
 
+    /**
+   * @brief Returns the number of entries of the CDF table S below search.
+   * Small tables are scanned in full so the run time is independent of the
+   * sample; larger tables use binary search.
+   */
+    static usint CountBelow(const std::vector<double>& S, double search);
+
+    /**
+   * @brief Draws one sample using Peikert's inversion method from the given
+   * PRNG. Does not throw so that it can be called inside OpenMP regions.
+   * @param g PRNG to draw the uniform deviate from
+   * @param sample the signed sample
+   * @return false if the deviate falls outside the precomputed table
+   */
+    bool SampleInversion(PRNG& g, int64_t& sample) const;
+
     static double UnnormalizedGaussianPDF(const double& mean, const double& sigma, int32_t x) {
         return pow(M_E, -pow(x - mean, 2) / (2. * sigma * sigma));
     }
@@ -80,6 +80,13 @@ public:
    */
     VecType GenerateVector(const usint size) const;
 
+    /**
+   * @brief Generates a vector of random integers drawn from the given PRNG
+   * instead of the shared one, so that the result only depends on the PRNG's
+   * seed. The modulus has to fit in a machine word.
+   */
+    VecType GenerateVector(const usint size, PRNG& prng) const;
+
 private:
     // discrete uniform generator relies on the built-in C++ generator for 32-bit
     // unsigned integers the constants below set the parameters specific to 32-bit
@@ -37,6 +37,7 @@
 #ifndef LBCRYPTO_MATH_DISTRIBUTIONGENERATOR_H_
 #define LBCRYPTO_MATH_DISTRIBUTIONGENERATOR_H_
 
+#include <array>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -54,9 +55,22 @@ namespace lbcrypto {
 // Defines the PRNG implementation used by OpenFHE.
 // The cryptographically secure PRNG used by OpenFHE is based on BLAKE2 hash
 // functions. A user can replace it with a different PRNG if desired by defining
-// the same methods as for the Blake2Engine class.
+// the same methods as for the Blake2Engine class: the C++11 engine interface
+// (result_type, min(), max(), operator()) used by the standard distributions,
+// and Fill(uint64_t*, size_t) used by the generators for bulk sampling.
 typedef Blake2Engine PRNG;
 
+// seed of a PRNG instance that is independent of the shared one, used where
+// random values have to be reproducible from a seed (see DCRTPolyImpl)
+typedef std::array<PRNG::result_type, 16> PRNGSeed;
+
+// Random vectors of at least this length are sampled in parallel, each OpenMP
+// thread drawing from its own PRNG
+const usint PARALLEL_SAMPLING_THRESHOLD = 4096;
+
+// number of 64-bit words the generators request from PRNG::Fill at a time
+const usint PRNG_FILL_WORDS = 64;
+
 /**
  * @brief The class providing the PRNG capability to all random distribution
  * generators in OpenFHE. THe security of Ring Learning With Errors (used for
@@ -174,6 +188,32 @@ public:
         return *m_prng;
     }
 
+    /**
+   * @brief Returns a fresh 256-bit seed for a PRNGSeed drawn from the shared
+   * PRNG. The remaining words are zero and can be used to derive several
+   * streams from one seed.
+   */
+    static PRNGSeed GenerateSeed() {
+        PRNGSeed seed{};
+        auto& prng = GetPRNG();
+        for (size_t i = 0; i < 8; i++)
+            seed[i] = prng();
+        return seed;
+    }
+
+    /**
+   * @brief Returns true if a random vector of the given length should be
+   * sampled in parallel. Always false with FIXED_SEED, where the PRNG is shared
+   * by all threads.
+   */
+    static bool ParallelSampling(usint size) {
+#if defined(FIXED_SEED)
+        return false;
+#else
+        return size >= PARALLEL_SAMPLING_THRESHOLD;
+#endif
+    }
+
 private:
     // shared pointer to a thread-specific PRNG engine
     static std::shared_ptr<PRNG> m_prng;
@@ -185,6 +225,47 @@ private:
 #endif
 };
 
+/**
+ * @brief Buffered reader over PRNG::Fill used by the generators for bulk
+ * sampling. An instance should be used by a single thread only.
+ */
+class PRNGBuffer {
+public:
+    explicit PRNGBuffer(PRNG& prng) : m_prng(prng) {}
+
+    /**
+   * @brief Returns the next random 64-bit word
+   */
+    uint64_t NextWord() {
+        if (m_index == PRNG_FILL_WORDS) {
+            m_prng.Fill(m_words, PRNG_FILL_WORDS);
+            m_index = 0;
+        }
+        return m_words[m_index++];
+    }
+
+    /**
+   * @brief Returns the next numBits random bits; numBits must divide 64
+   */
+    uint32_t NextBits(usint numBits) {
+        if (m_bitsLeft == 0) {
+            m_bits     = NextWord();
+            m_bitsLeft = 64;
+        }
+        uint32_t result = m_bits & ((uint64_t(1) << numBits) - 1);
+        m_bits >>= numBits;
+        m_bitsLeft -= numBits;
+        return result;
+    }
+
+private:
+    PRNG& m_prng;
+    uint64_t m_words[PRNG_FILL_WORDS];
+    usint m_index    = PRNG_FILL_WORDS;
+    uint64_t m_bits  = 0;
+    usint m_bitsLeft = 0;
+};
+
 /**
  * @brief Abstract class describing generator requirements.
  *
@@ -275,6 +275,18 @@ public:
         return (this->m_data[idx]);
     }
 
+    /**
+   * Direct access to the underlying array; valid (possibly null) for an empty vector too.
+   * @return pointer to the first value.
+   */
+    IntegerType* data() {
+        return this->m_data.data();
+    }
+
+    const IntegerType* data() const {
+        return this->m_data.data();
+    }
+
     /**
    * Sets the vector modulus.
    *
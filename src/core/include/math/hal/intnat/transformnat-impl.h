@@ -765,6 +765,19 @@ void ChineseRemainderTransformFTTNat<VecType>::Reset() {
     m_rootOfUnityInversePreconReverseTableByModulus.clear();
 }
 
+template <typename VecType>
+size_t ChineseRemainderTransformFTTNat<VecType>::GetMemoryUsage() {
+    size_t bytes = 0;
+    for (const auto* table :
+         {&m_cycloOrderInverseTableByModulus, &m_cycloOrderInversePreconTableByModulus,
+          &m_rootOfUnityReverseTableByModulus, &m_rootOfUnityInverseReverseTableByModulus,
+          &m_rootOfUnityPreconReverseTableByModulus, &m_rootOfUnityInversePreconReverseTableByModulus}) {
+        for (const auto& entry : *table)
+            bytes += sizeof(entry) + entry.second.GetLength() * sizeof(IntType);
+    }
+    return bytes;
+}
+
 template <typename VecType>
 void BluesteinFFTNat<VecType>::PreComputeDefaultNTTModulusRoot(usint cycloOrder, const IntType& modulus) {
     usint nttDim          = pow(2, ceil(log2(2 * cycloOrder - 1)));
@@ -344,6 +344,12 @@ public:
    */
     void Reset();
 
+    /**
+   * Returns the number of bytes held by the precomputed root of unity tables
+   * (the coefficient storage of all cached vectors).
+   */
+    static size_t GetMemoryUsage();
+
     /// map to store the cyclo order inverse with modulus as a key
     /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
     static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
@@ -495,6 +495,15 @@ uint32_t FindAutomorphismIndexCyclic(int32_t i, uint32_t m, uint32_t g);
  */
 void PrecomputeAutoMap(uint32_t n, uint32_t k, std::vector<uint32_t>* precomp);
 
+/**
+ * Returns the bit reversal map for a specific automorphism, computing it on the
+ * first request and caching it for later calls. Thread-safe.
+ * @param n ring dimension
+ * @param k automorphism index
+ * @return the precomputed table
+ */
+const std::vector<uint32_t>& GetAutoMap(uint32_t n, uint32_t k);
+
 }  // namespace lbcrypto
 
 #endif
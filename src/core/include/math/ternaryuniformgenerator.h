@@ -85,7 +85,11 @@ public:
     std::shared_ptr<int32_t> GenerateIntVector(usint size, usint h = 0) const;
 
 private:
-    static std::uniform_int_distribution<int> m_distribution;
+    /**
+   * @brief Returns a uniform sample from {-1, 0, 1} drawn from buffered PRNG
+   * output.
+   */
+    static int32_t SampleTernary(PRNGBuffer& buffer);
 };
 
 }  // namespace lbcrypto
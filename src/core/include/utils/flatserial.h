@@ -0,0 +1,196 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Helpers for the flat binary format: native fixed-width values and raw arrays written without any envelope
+ */
+
+#ifndef LBCRYPTO_UTILS_FLATSERIAL_H
+#define LBCRYPTO_UTILS_FLATSERIAL_H
+
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace Serial {
+
+// Tags written at the start of every flat object. Values are stored in the byte order of the machine, so a
+// stream written on a machine of the other byte order is rejected by the tag check.
+constexpr uint32_t FLAT_TAG_DCRTPOLY        = 0x50444c46;  // "FLDP"
+constexpr uint32_t FLAT_TAG_DCRTPOLY_PACKED = 0x50504c46;  // "FLPP"
+constexpr uint32_t FLAT_TAG_CIPHERTEXT      = 0x54434c46;  // "FLCT"
+constexpr uint32_t FLAT_TAG_EVALKEY         = 0x4b454c46;  // "FLEK"
+constexpr uint32_t FLAT_TAG_KEYBUNDLE       = 0x424b4c46;  // "FLKB"
+constexpr uint32_t FLAT_TAG_LWE             = 0x574c4c46;  // "FLLW"
+
+// Upper bounds on sizes read from a flat stream, checked before anything is allocated for them
+constexpr uint64_t FLAT_MAX_STRING_SIZE = 1 << 16;
+constexpr uint32_t FLAT_MAX_ELEMENTS    = 64;
+
+/**
+ * Writes count values as one raw block. T has to be a plain value type (fixed-width integers, double or the
+ * native integer wrappers)
+ */
+template <typename T>
+void WriteFlat(std::ostream& os, const T* data, size_t count) {
+    os.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+void WriteFlat(std::ostream& os, const T& value) {
+    WriteFlat(os, &value, 1);
+}
+
+/**
+ * Reads count values written by WriteFlat straight into data
+ */
+template <typename T>
+void ReadFlat(std::istream& is, T* data, size_t count) {
+    if (!is.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T))))
+        OPENFHE_THROW(deserialize_error, "unexpected end of a flat binary stream");
+}
+
+template <typename T>
+T ReadFlat(std::istream& is) {
+    T value;
+    ReadFlat(is, &value, 1);
+    return value;
+}
+
+/**
+ * Writes a string as its length and its characters, zero-padded to a multiple of 8 bytes so that the arrays
+ * following it stay aligned
+ */
+inline void WriteFlatString(std::ostream& os, const std::string& str) {
+    WriteFlat(os, static_cast<uint64_t>(str.size()));
+    WriteFlat(os, str.data(), str.size());
+    const char padding[8] = {};
+    WriteFlat(os, padding, (8 - str.size() % 8) % 8);
+}
+
+inline std::string ReadFlatString(std::istream& is) {
+    const auto size = ReadFlat<uint64_t>(is);
+    if (size > FLAT_MAX_STRING_SIZE)
+        OPENFHE_THROW(deserialize_error,
+                      "a string of " + std::to_string(size) + " bytes in a flat binary stream is too long");
+    std::string str(size, '\0');
+    ReadFlat(is, &str[0], str.size());
+    char padding[8];
+    ReadFlat(is, padding, (8 - str.size() % 8) % 8);
+    return str;
+}
+
+/**
+ * Reads size raw bytes into str. The string grows with the bytes actually read, so a corrupt size runs into the
+ * end of the stream instead of being allocated up front
+ */
+inline void ReadFlatBytes(std::istream& is, std::string& str, uint64_t size) {
+    constexpr uint64_t chunk = 1 << 20;
+    str.clear();
+    str.reserve(std::min(size, chunk));
+    while (str.size() < size) {
+        const size_t done = str.size();
+        str.resize(done + std::min(size - done, chunk));
+        ReadFlat(is, &str[done], str.size() - done);
+    }
+}
+
+/**
+ * Read-only stream buffer over memory owned by the caller, so that a flat object already held in memory is
+ * parsed without copying it into a stringstream
+ */
+class FlatBuffer : public std::streambuf {
+public:
+    FlatBuffer(const char* data, size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+/**
+ * Packs values below 2^bits (1 <= bits <= 64) into consecutive 64-bit words, least significant bits first
+ */
+inline std::vector<uint64_t> PackBits(const uint64_t* values, size_t count, uint32_t bits) {
+    std::vector<uint64_t> packed((count * bits + 63) / 64);
+    size_t word   = 0;
+    uint32_t used = 0;
+    uint64_t acc  = 0;
+    for (size_t i = 0; i < count; i++) {
+        acc |= values[i] << used;
+        used += bits;
+        if (used >= 64) {
+            packed[word++] = acc;
+            used -= 64;
+            acc = used ? values[i] >> (bits - used) : 0;
+        }
+    }
+    if (used)
+        packed[word] = acc;
+    return packed;
+}
+
+/**
+ * Unpacks count values of the given bit width written by PackBits
+ */
+inline void UnpackBits(const uint64_t* packed, uint64_t* values, size_t count, uint32_t bits) {
+    const uint64_t mask = (bits == 64) ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    size_t bitPos       = 0;
+    for (size_t i = 0; i < count; i++, bitPos += bits) {
+        const size_t word  = bitPos >> 6;
+        const uint32_t bit = bitPos & 63;
+        uint64_t value     = packed[word] >> bit;
+        if (bit + bits > 64)
+            value |= packed[word + 1] << (64 - bit);
+        values[i] = value & mask;
+    }
+}
+
+/**
+ * Reads the tag at the start of a flat object and throws if it is not the expected one
+ */
+inline void CheckFlatTag(std::istream& is, uint32_t tag, const std::string& name) {
+    if (ReadFlat<uint32_t>(is) != tag)
+        OPENFHE_THROW(deserialize_error, "the stream does not hold a flat " + name + " written in this byte order");
+}
+
+}  // namespace Serial
+
+}  // namespace lbcrypto
+
+#endif
@@ -0,0 +1,188 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Thread-local counters and optional timers for the hot-path operations (NTTs, base conversions,
+  key switching, automorphisms, rescaling and blind-rotation accumulation)
+ */
+
+#ifndef SRC_CORE_LIB_UTILS_OPCOUNTERS_H_
+#define SRC_CORE_LIB_UTILS_OPCOUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace lbcrypto {
+
+/**
+ * @brief Hot-path operations tracked by the operation counters
+ */
+enum OpCounterType {
+    OPCOUNT_NTT = 0,       // forward NTT of a single tower (PolyImpl::SwitchFormat)
+    OPCOUNT_INTT,          // inverse NTT of a single tower (PolyImpl::SwitchFormat)
+    OPCOUNT_BASECONV,      // approximate CRT basis switch (DCRTPoly::ApproxSwitchCRTBasis)
+    OPCOUNT_KEYSWITCH,     // key-switching inner product (KeySwitchCore and the hoisted variants)
+    OPCOUNT_AUTOMORPHISM,  // automorphism of a DCRTPoly
+    OPCOUNT_RESCALE,       // level dropped by ModReduceInternalInPlace
+    OPCOUNT_EVALACC,       // RGSW accumulator evaluation (RingGSWAccumulator::EvalAcc)
+    OPCOUNT_NUM_TYPES
+};
+
+std::ostream& operator<<(std::ostream& s, OpCounterType op);
+
+/**
+ * @brief Counts and accumulated time (in nanoseconds) for every OpCounterType.
+ * Times are only collected while timers are enabled and are summed over all threads,
+ * so nested operations (e.g. the NTTs inside a key switch) are included in the time
+ * of the enclosing operation as well.
+ */
+struct OpCounterSnapshot {
+    std::array<uint64_t, OPCOUNT_NUM_TYPES> counts{};
+    std::array<uint64_t, OPCOUNT_NUM_TYPES> nanoseconds{};
+
+    uint64_t GetCount(OpCounterType op) const {
+        return counts[op];
+    }
+
+    uint64_t GetNanoseconds(OpCounterType op) const {
+        return nanoseconds[op];
+    }
+
+    /**
+   * Subtracts another snapshot; useful to get the cost of a code region without resetting
+   * @param rhs snapshot taken earlier
+   * @return per-operation differences
+   */
+    OpCounterSnapshot operator-(const OpCounterSnapshot& rhs) const;
+
+    /**
+   * @return the snapshot as a JSON object of the form {"NTT":{"count":N,"ns":T},...}
+   */
+    std::string ToJSON() const;
+};
+
+std::ostream& operator<<(std::ostream& s, const OpCounterSnapshot& snapshot);
+
+/**
+ * @brief Per-thread storage for the counters. Each block is written only by its owning
+ * thread, so an increment is a relaxed load/store pair without any locked instructions.
+ */
+struct OpCounterBlock {
+    std::array<std::atomic<uint64_t>, OPCOUNT_NUM_TYPES> counts{};
+    std::array<std::atomic<uint64_t>, OPCOUNT_NUM_TYPES> nanoseconds{};
+};
+
+class OpCounters {
+public:
+    /**
+   * Adds n to the counter of op for the calling thread
+   */
+    static void Increment(OpCounterType op, uint64_t n = 1) {
+        auto& c = GetThreadBlock().counts[op];
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    /**
+   * Adds ns nanoseconds to the timer of op for the calling thread
+   */
+    static void AddTime(OpCounterType op, uint64_t ns) {
+        auto& t = GetThreadBlock().nanoseconds[op];
+        t.store(t.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    }
+
+    static bool TimersEnabled() {
+        return s_timersEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+   * Turns the scoped timers on or off for all threads; the counters are always on
+   */
+    static void EnableTimers(bool enable = true) {
+        s_timersEnabled.store(enable, std::memory_order_relaxed);
+    }
+
+    /**
+   * @return the counters summed over all threads that have ever recorded an operation
+   */
+    static OpCounterSnapshot GetSnapshot();
+
+    /**
+   * Zeroes the counters of all threads. Operations running concurrently with the reset
+   * may or may not be included in the next snapshot.
+   */
+    static void Reset();
+
+private:
+    static OpCounterBlock& GetThreadBlock() {
+        thread_local OpCounterBlock* block = RegisterThreadBlock();
+        return *block;
+    }
+
+    static OpCounterBlock* RegisterThreadBlock();
+
+    static std::atomic<bool> s_timersEnabled;
+};
+
+/**
+ * @brief RAII helper placed at the top of an instrumented function: counts n operations
+ * and, if timers are enabled, adds the time spent in the enclosing scope
+ */
+class OpCounterScope {
+public:
+    explicit OpCounterScope(OpCounterType op, uint64_t n = 1) : m_op(op), m_timed(OpCounters::TimersEnabled()) {
+        OpCounters::Increment(op, n);
+        if (m_timed)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~OpCounterScope() {
+        if (m_timed) {
+            auto elapsed = std::chrono::steady_clock::now() - m_start;
+            OpCounters::AddTime(m_op, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    OpCounterScope(const OpCounterScope&)            = delete;
+    OpCounterScope& operator=(const OpCounterScope&) = delete;
+
+private:
+    OpCounterType m_op;
+    bool m_timed;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_LIB_UTILS_OPCOUNTERS_H_
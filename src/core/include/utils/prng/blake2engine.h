@@ -40,6 +40,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <array>
 #include <limits>
 
@@ -119,6 +120,38 @@ class Blake2Engine {
     return result;
   }
 
+  /**
+   * @brief bulk call to the PRNG: fills out with n random 64-bit words. Uses
+   * the same stream as operator(), but whole blocks are generated directly
+   * into out without going through the buffer
+   */
+  void Fill(uint64_t* out, size_t n) {
+    uint8_t* dst = reinterpret_cast<uint8_t*>(out);
+    size_t bytes = n * sizeof(uint64_t);
+
+    // first consume the samples left in the buffer
+    if (m_bufferIndex != 0 && m_bufferIndex != PRNG_BUFFER_SIZE) {
+      size_t len = std::min(bytes, (PRNG_BUFFER_SIZE - m_bufferIndex) *
+                                       sizeof(result_type));
+      memcpy(dst, &m_buffer[m_bufferIndex], len);
+      m_bufferIndex += len / sizeof(result_type);
+      dst += len;
+      bytes -= len;
+      if (bytes == 0) return;
+    }
+    m_bufferIndex = PRNG_BUFFER_SIZE;
+
+    const size_t blockBytes = PRNG_BUFFER_SIZE * sizeof(result_type);
+    for (; bytes >= blockBytes; dst += blockBytes, bytes -= blockBytes)
+      Generate(dst, blockBytes);
+
+    if (bytes > 0) {
+      Generate();
+      memcpy(dst, m_buffer.data(), bytes);
+      m_bufferIndex = bytes / sizeof(result_type);
+    }
+  }
+
   Blake2Engine(const Blake2Engine& other) {
     m_counter = other.m_counter;
     m_seed = other.m_seed;
@@ -138,10 +171,16 @@ class Blake2Engine {
    * @brief The main call to blake2xb function
    */
   void Generate() {
-    // m_counter is the input to the hash function
     // m_buffer is the output
-    if (blake2xb(m_buffer.begin(), m_buffer.size() * sizeof(result_type),
-                 &m_counter, sizeof(m_counter), m_seed.cbegin(),
+    Generate(m_buffer.begin(), m_buffer.size() * sizeof(result_type));
+  }
+
+  /**
+   * @brief Generates one block of outlen bytes for the current counter
+   */
+  void Generate(void* out, size_t outlen) {
+    // m_counter is the input to the hash function
+    if (blake2xb(out, outlen, &m_counter, sizeof(m_counter), m_seed.cbegin(),
                  m_seed.size() * sizeof(result_type)) != 0) {
       OPENFHE_THROW(math_error, "PRNG: blake2xb failed");
     }
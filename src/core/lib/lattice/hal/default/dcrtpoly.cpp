@@ -33,11 +33,13 @@
   Implementation of the integer lattice using double-CRT representations
  */
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
 #include "lattice/lat-hal.h"
 #include "utils/debug.h"
+#include "utils/opcounters.h"
 #include "utils/utilities-int.h"
 #include "utils/utilities.h"
 
@@ -213,23 +215,27 @@ DCRTPolyImpl<VecType>::DCRTPolyImpl(const DggType& dgg, const std::shared_ptr<DC
     size_t vecSize = dcrtParams->GetParams().size();
     m_vectors.reserve(vecSize);
 
+    usint ringDim     = dcrtParams->GetRingDimension();
+    double dgg_stddev = dgg.GetStd();
+
     // dgg generating random values
-    std::shared_ptr<int64_t> dggValues = dgg.GenerateIntVector(dcrtParams->GetRingDimension());
+    std::shared_ptr<int64_t> dggValues = dgg.GenerateIntVector(ringDim);
 
     for (usint i = 0; i < vecSize; i++) {
-        NativeVector ilDggValues(dcrtParams->GetRingDimension(), dcrtParams->GetParams()[i]->GetModulus());
+        const NativeInteger& modulus = dcrtParams->GetParams()[i]->GetModulus();
+        NativeVector ilDggValues(ringDim, modulus);
 
-        for (usint j = 0; j < dcrtParams->GetRingDimension(); j++) {
+        auto dcrt_qmodulus = (NativeInteger::SignedNativeInt)modulus.ConvertToInt();
+        bool reduce        = dgg_stddev > dcrt_qmodulus;
+
+        for (usint j = 0; j < ringDim; j++) {
             NativeInteger::Integer entry;
             // if the random generated value is less than zero, then multiply it by
             // (-1) and subtract the modulus of the current tower to set the
             // coefficient
             NativeInteger::SignedNativeInt k = (dggValues.get())[j];
-            auto dcrt_qmodulus =
-                (NativeInteger::SignedNativeInt)dcrtParams->GetParams()[i]->GetModulus().ConvertToInt();
-            auto dgg_stddev = dgg.GetStd();
 
-            if (dgg_stddev > dcrt_qmodulus) {
+            if (reduce) {
                 // rescale k to dcrt_qmodulus
                 auto mk = k % dcrt_qmodulus;
                 k       = (NativeInteger::Integer)mk;
@@ -277,6 +283,30 @@ DCRTPolyImpl<VecType>::DCRTPolyImpl(DugType& dug, const std::shared_ptr<DCRTPoly
     }
 }
 
+template <typename VecType>
+DCRTPolyImpl<VecType>::DCRTPolyImpl(const PRNGSeed& seed, const std::shared_ptr<DCRTPolyImpl::Params> dcrtParams,
+                                    Format format) {
+    this->m_format = format;
+    this->m_params = dcrtParams;
+
+    size_t numberOfTowers = dcrtParams->GetParams().size();
+    m_vectors.resize(numberOfTowers);
+
+#pragma omp parallel for
+    for (size_t i = 0; i < numberOfTowers; i++) {
+        PRNGSeed towerSeed = seed;
+        towerSeed.back()   = static_cast<PRNG::result_type>(i);
+        PRNG prng(towerSeed);
+
+        DugType dug;
+        dug.SetModulus(dcrtParams->GetParams()[i]->GetModulus());
+
+        PolyType ilvector(dcrtParams->GetParams()[i]);
+        ilvector.SetValues(dug.GenerateVector(dcrtParams->GetRingDimension(), prng), format);
+        m_vectors[i] = std::move(ilvector);
+    }
+}
+
 template <typename VecType>
 DCRTPolyImpl<VecType>::DCRTPolyImpl(const BugType& bug, const std::shared_ptr<DCRTPolyImpl::Params> dcrtParams,
                                     Format format) {
@@ -1151,6 +1181,124 @@ const typename DCRTPolyImpl<VecType>::Integer& DCRTPolyImpl<VecType>::operator[]
     return tmp[i];
 }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+/*
+ * Reconstructs values modulo Q = q_0 * ... * q_{l-1} from their residues with native arithmetic only. The value
+ * x with residues x_i is sum_i y_i * (Q/q_i) - v * Q, where y_i = [x_i * (Q/q_i)^{-1}]_{q_i} and v is the integer
+ * part of sum_i y_i / q_i. As in ScaleAndRound, v is estimated in floating point; the sum is accumulated exactly
+ * in l + 1 little-endian 64-bit limbs, so the estimate only has to be within one of v and is corrected by
+ * comparing the limbs with Q.
+ */
+class CRTReconstruction {
+public:
+    explicit CRTReconstruction(const std::vector<NativeInteger>& moduli)
+        : m_moduli(moduli),
+          m_QHatInvModq(moduli.size()),
+          m_QHatInvModqPrecon(moduli.size()),
+          m_qInv(moduli.size()),
+          m_QHat(moduli.size(), std::vector<uint64_t>(moduli.size() + 1)),
+          m_Q(moduli.size() + 1) {
+        const size_t size = moduli.size();
+        m_Q[0]            = 1;
+        for (size_t i = 0; i < size; i++) {
+            std::vector<uint64_t> product(Limbs());
+            MulAdd(product.data(), m_Q.data(), moduli[i].ConvertToInt());
+            m_Q = std::move(product);
+
+            NativeInteger QHatModqi(1);
+            m_QHat[i][0] = 1;
+            for (size_t j = 0; j < size; j++) {
+                if (j == i)
+                    continue;
+                QHatModqi = QHatModqi.ModMul(moduli[j], moduli[i]);
+                std::vector<uint64_t> QHat(Limbs());
+                MulAdd(QHat.data(), m_QHat[i].data(), moduli[j].ConvertToInt());
+                m_QHat[i] = std::move(QHat);
+            }
+            m_QHatInvModq[i]       = QHatModqi.ModInverse(moduli[i]);
+            m_QHatInvModqPrecon[i] = m_QHatInvModq[i].PrepModMulConst(moduli[i]);
+            m_qInv[i]              = 1.0 / moduli[i].ConvertToDouble();
+        }
+    }
+
+    // number of limbs of a reconstructed value
+    size_t Limbs() const {
+        return m_moduli.size() + 1;
+    }
+
+    const std::vector<uint64_t>& GetModulus() const {
+        return m_Q;
+    }
+
+    /*
+     * Writes the value in [0, Q) with the residues towers[i][ri] to result; tmp is scratch space. Both have
+     * Limbs() limbs.
+     */
+    template <typename PolyType>
+    void Reconstruct(const std::vector<PolyType>& towers, usint ri, uint64_t* result, uint64_t* tmp) const {
+        const size_t limbs = Limbs();
+        std::fill(result, result + limbs, 0);
+        double quotient = 0;
+        for (size_t i = 0; i < m_moduli.size(); i++) {
+            const uint64_t yi =
+                towers[i][ri].ModMulFastConst(m_QHatInvModq[i], m_moduli[i], m_QHatInvModqPrecon[i]).ConvertToInt();
+            MulAdd(result, m_QHat[i].data(), yi);
+            quotient += static_cast<double>(yi) * m_qInv[i];
+        }
+
+        // one less than the estimate, so that the subtraction cannot go below zero
+        uint64_t v = static_cast<uint64_t>(quotient);
+        if (v > 0) {
+            std::fill(tmp, tmp + limbs, 0);
+            MulAdd(tmp, m_Q.data(), v - 1);
+            Sub(result, tmp);
+        }
+        while (!Less(result, m_Q.data()))
+            Sub(result, m_Q.data());
+    }
+
+    // true if a < b
+    bool Less(const uint64_t* a, const uint64_t* b) const {
+        for (size_t k = Limbs(); k-- > 0;) {
+            if (a[k] != b[k])
+                return a[k] < b[k];
+        }
+        return false;
+    }
+
+private:
+    // acc += a * b; the result has to fit in Limbs() limbs
+    void MulAdd(uint64_t* acc, const uint64_t* a, uint64_t b) const {
+        uint64_t carry = 0;
+        for (size_t k = 0; k < Limbs(); k++) {
+            DoubleNativeInt t = Mul128(a[k], b) + acc[k] + carry;
+            acc[k]            = static_cast<uint64_t>(t);
+            carry             = static_cast<uint64_t>(t >> 64);
+        }
+    }
+
+    // acc -= b, for acc >= b
+    void Sub(uint64_t* acc, const uint64_t* b) const {
+        uint64_t borrow = 0;
+        for (size_t k = 0; k < Limbs(); k++) {
+            const uint64_t bk = b[k] + borrow;
+            borrow            = (bk < borrow) || (acc[k] < bk);
+            acc[k] -= bk;
+        }
+    }
+
+    std::vector<NativeInteger> m_moduli;
+    // [(Q/q_i)^{-1}]_{q_i}
+    std::vector<NativeInteger> m_QHatInvModq;
+    std::vector<NativeInteger> m_QHatInvModqPrecon;
+    // 1/q_i
+    std::vector<double> m_qInv;
+    // Q/q_i
+    std::vector<std::vector<uint64_t>> m_QHat;
+    std::vector<uint64_t> m_Q;
+};
+#endif
+
 /*
  * This method applies the Chinese Remainder Interpolation on an DCRTPolyImpl
  * and produces an Poly How the Algorithm works: Consider the DCRTPolyImpl as
@@ -1165,6 +1313,59 @@ const typename DCRTPolyImpl<VecType>::Integer& DCRTPolyImpl<VecType>::operator[]
  * Once we have the V values, we construct an Poly from V, use qt as it's
  * modulus, and calculate a root of unity for parameter selection of the Poly.
  */
+#if defined(HAVE_INT128) && NATIVEINT == 64
+template <typename VecType>
+typename DCRTPolyImpl<VecType>::PolyLargeType DCRTPolyImpl<VecType>::CRTInterpolate() const {
+    usint ringDimension = this->GetRingDimension();
+    usint nTowers       = m_vectors.size();
+
+    const std::vector<PolyType>* vecs = &m_vectors;
+    std::vector<PolyType> coeffVecs;
+    if (this->GetFormat() == Format::EVALUATION) {
+        coeffVecs = m_vectors;
+    #pragma omp parallel for if (nTowers > 1)
+        for (usint i = 0; i < nTowers; i++)
+            coeffVecs[i].SetFormat(Format::COEFFICIENT);
+        vecs = &coeffVecs;
+    }
+
+    std::vector<NativeInteger> moduli(nTowers);
+    for (usint i = 0; i < nTowers; i++)
+        moduli[i] = m_vectors[i].GetModulus();
+    const CRTReconstruction crt(moduli);
+    const size_t limbs = crt.Limbs();
+
+    Integer bigModulus(this->GetModulus());
+    VecType coefficients(ringDimension, bigModulus);
+
+    // the coefficients are built from native limbs; no multiprecision multiplication or reduction is needed
+    #pragma omp parallel
+    {
+        std::vector<uint64_t> value(limbs);
+        std::vector<uint64_t> tmp(limbs);
+    #pragma omp for
+        for (usint ri = 0; ri < ringDimension; ri++) {
+            crt.Reconstruct(*vecs, ri, value.data(), tmp.data());
+            size_t top = limbs - 1;
+            while (top > 0 && value[top] == 0)
+                top--;
+            Integer coefficient(value[top]);
+            for (size_t k = top; k-- > 0;) {
+                coefficient <<= 64;
+                coefficient += Integer(value[k]);
+            }
+            coefficients[ri] = std::move(coefficient);
+        }
+    }
+
+    // Setting the root of unity to ONE as the calculation is expensive and not
+    // required.
+    typename DCRTPolyImpl<VecType>::PolyLargeType polynomialReconstructed(
+        std::make_shared<ILParamsImpl<Integer>>(this->GetCyclotomicOrder(), bigModulus, 1));
+    polynomialReconstructed.SetValues(std::move(coefficients), COEFFICIENT);
+    return polynomialReconstructed;
+}
+#else
 template <typename VecType>
 typename DCRTPolyImpl<VecType>::PolyLargeType DCRTPolyImpl<VecType>::CRTInterpolate() const {
     OPENFHE_DEBUG_FLAG(false);
@@ -1248,6 +1449,7 @@ typename DCRTPolyImpl<VecType>::PolyLargeType DCRTPolyImpl<VecType>::CRTInterpol
 
     return polynomialReconstructed;
 }
+#endif
 
 /*
  * This method applies the Chinese Remainder Interpolation on a
@@ -1354,7 +1556,59 @@ typename DCRTPolyImpl<VecType>::PolyLargeType DCRTPolyImpl<VecType>::CRTInterpol
 // todo can we be smarter with this method?
 template <typename VecType>
 NativePoly DCRTPolyImpl<VecType>::DecryptionCRTInterpolate(PlaintextModulus ptm) const {
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // the centered value modulo Q is reduced modulo ptm straight from its limbs
+    usint ringDimension = this->GetRingDimension();
+    usint nTowers       = m_vectors.size();
+
+    const std::vector<PolyType>* vecs = &m_vectors;
+    std::vector<PolyType> coeffVecs;
+    if (this->GetFormat() == Format::EVALUATION) {
+        coeffVecs = m_vectors;
+    #pragma omp parallel for if (nTowers > 1)
+        for (usint i = 0; i < nTowers; i++)
+            coeffVecs[i].SetFormat(Format::COEFFICIENT);
+        vecs = &coeffVecs;
+    }
+
+    std::vector<NativeInteger> moduli(nTowers);
+    for (usint i = 0; i < nTowers; i++)
+        moduli[i] = m_vectors[i].GetModulus();
+    const CRTReconstruction crt(moduli);
+    const size_t limbs = crt.Limbs();
+
+    // values above Q/2 stand for value - Q
+    const auto& Q = crt.GetModulus();
+    std::vector<uint64_t> halfQ(limbs);
+    for (size_t k = 0; k < limbs; k++)
+        halfQ[k] = (Q[k] >> 1) | ((k + 1 < limbs) ? (Q[k + 1] << 63) : 0);
+    auto modt = [ptm, limbs](const uint64_t* value) {
+        DoubleNativeInt r = 0;
+        for (size_t k = limbs; k-- > 0;)
+            r = ((r << 64) | value[k]) % ptm;
+        return NativeInteger(static_cast<uint64_t>(r));
+    };
+    const NativeInteger t(ptm);
+    const NativeInteger QModt = modt(Q.data());
+
+    NativePoly interp(std::make_shared<ILNativeParams>(this->GetCyclotomicOrder(), ptm, 1), Format::COEFFICIENT, true);
+    #pragma omp parallel
+    {
+        std::vector<uint64_t> value(limbs);
+        std::vector<uint64_t> tmp(limbs);
+    #pragma omp for
+        for (usint ri = 0; ri < ringDimension; ri++) {
+            crt.Reconstruct(*vecs, ri, value.data(), tmp.data());
+            NativeInteger valueModt = modt(value.data());
+            if (crt.Less(halfQ.data(), value.data()))
+                valueModt.ModSubEq(QModt, t);
+            interp[ri] = valueModt;
+        }
+    }
+    return interp;
+#else
     return this->CRTInterpolate().DecryptionCRTInterpolate(ptm);
+#endif
 }
 
 // todo can we be smarter with this method?
@@ -1419,6 +1673,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     const std::shared_ptr<DCRTPolyImpl::Params> paramsQ, const std::shared_ptr<DCRTPolyImpl::Params> paramsP,
     const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
     const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
+    OpCounterScope opCount(OPCOUNT_BASECONV);
     DCRTPolyType ans(paramsP, this->GetFormat(), true);
 
     usint ringDim = this->GetRingDimension();
@@ -1451,6 +1706,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     const std::shared_ptr<DCRTPolyImpl::Params> paramsQ, const std::shared_ptr<DCRTPolyImpl::Params> paramsP,
     const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
     const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
+    OpCounterScope opCount(OPCOUNT_BASECONV);
     DCRTPolyType ans(paramsP, this->GetFormat(), true);
 
     usint sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
@@ -3224,6 +3480,132 @@ double DCRTPolyImpl<VecType>::Norm() const {
     return poly.Norm();
 }
 
+template <typename VecType>
+void DCRTPolyImpl<VecType>::SerializeFlat(std::ostream& os, bool bitPacked) const {
+    const uint32_t towers  = m_vectors.size();
+    const uint32_t ringDim = this->GetRingDimension();
+
+    // towers whose modulus does not fit a 64-bit word are never packed
+    for (const auto& tower : m_vectors)
+        bitPacked = bitPacked && tower.GetModulus().GetMSB() <= 64;
+
+    Serial::WriteFlat(os, bitPacked ? Serial::FLAT_TAG_DCRTPOLY_PACKED : Serial::FLAT_TAG_DCRTPOLY);
+    Serial::WriteFlat(os, static_cast<uint32_t>(1));
+    Serial::WriteFlat(os, ringDim);
+    Serial::WriteFlat(os, towers);
+    Serial::WriteFlat(os, static_cast<uint32_t>(this->m_format));
+    Serial::WriteFlat(os, static_cast<uint32_t>(sizeof(NativeInteger)));
+    for (const auto& tower : m_vectors)
+        Serial::WriteFlat(os, tower.GetModulus());
+
+    if (!bitPacked) {
+        for (const auto& tower : m_vectors)
+            Serial::WriteFlat(os, &tower.GetValues()[0], ringDim);
+        return;
+    }
+
+    std::vector<std::vector<uint64_t>> packed(towers);
+#pragma omp parallel for if (towers > 1)
+    for (uint32_t i = 0; i < towers; i++) {
+        const auto& values = m_vectors[i].GetValues();
+        std::vector<uint64_t> words(ringDim);
+        for (uint32_t j = 0; j < ringDim; j++)
+            words[j] = values[j].template ConvertToInt<uint64_t>();
+        packed[i] = Serial::PackBits(words.data(), ringDim, m_vectors[i].GetModulus().GetMSB());
+    }
+    for (const auto& words : packed)
+        Serial::WriteFlat(os, words.data(), words.size());
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::DeserializeFlat(std::istream& is, const std::shared_ptr<Params>& params) {
+    const auto tag = Serial::ReadFlat<uint32_t>(is);
+    if (tag != Serial::FLAT_TAG_DCRTPOLY && tag != Serial::FLAT_TAG_DCRTPOLY_PACKED)
+        OPENFHE_THROW(deserialize_error, "the stream does not hold a flat DCRTPoly written in this byte order");
+    const auto version  = Serial::ReadFlat<uint32_t>(is);
+    const auto ringDim  = Serial::ReadFlat<uint32_t>(is);
+    const auto towers   = Serial::ReadFlat<uint32_t>(is);
+    const auto format   = static_cast<Format>(Serial::ReadFlat<uint32_t>(is));
+    const auto wordSize = Serial::ReadFlat<uint32_t>(is);
+    if (version > 1)
+        OPENFHE_THROW(deserialize_error, "flat DCRTPoly version " + std::to_string(version) +
+                                             " is from a later version of the library");
+    // level-reduced and compressed elements hold a subset of the towers
+    if (wordSize != sizeof(NativeInteger) || ringDim != params->GetRingDimension() || towers == 0 ||
+        towers > params->GetParams().size())
+        OPENFHE_THROW(deserialize_error, "the flat DCRTPoly does not match the given parameters");
+
+    std::vector<NativeInteger> moduli(towers);
+    Serial::ReadFlat(is, moduli.data(), towers);
+
+    // the towers select their parameters by modulus
+    const auto& candidates = params->GetParams();
+    std::vector<std::shared_ptr<ILNativeParams>> towerParams(towers);
+    bool samePrefix = true;
+    for (uint32_t i = 0; i < towers; i++) {
+        for (const auto& candidate : candidates) {
+            if (candidate->GetModulus() == moduli[i]) {
+                towerParams[i] = candidate;
+                break;
+            }
+        }
+        if (towerParams[i] == nullptr)
+            OPENFHE_THROW(deserialize_error, "modulus " + moduli[i].ToString() + " of the flat DCRTPoly is unknown");
+        for (uint32_t k = 0; k < i; k++) {
+            if (moduli[k] == moduli[i])
+                OPENFHE_THROW(deserialize_error, "modulus " + moduli[i].ToString() + " of the flat DCRTPoly repeats");
+        }
+        samePrefix = samePrefix && towerParams[i] == candidates[i];
+    }
+
+    if (samePrefix && towers == candidates.size())
+        this->m_params = params;
+    else
+        this->m_params = std::make_shared<Params>(params->GetCyclotomicOrder(), towerParams,
+                                                  params->GetOriginalModulus());
+    this->m_format = format;
+
+    std::vector<NativeVector> values;
+    values.reserve(towers);
+    for (uint32_t i = 0; i < towers; i++)
+        values.emplace_back(ringDim, moduli[i]);
+
+    if (tag == Serial::FLAT_TAG_DCRTPOLY) {
+        for (auto& tower : values)
+            Serial::ReadFlat(is, &tower[0], ringDim);
+    }
+    else {
+        std::vector<std::vector<uint64_t>> packed(towers);
+        for (uint32_t i = 0; i < towers; i++) {
+            if (moduli[i].GetMSB() > 64)
+                OPENFHE_THROW(deserialize_error, "a bit-packed tower of the flat DCRTPoly is wider than 64 bits");
+            packed[i].resize((static_cast<size_t>(ringDim) * moduli[i].GetMSB() + 63) / 64);
+            Serial::ReadFlat(is, packed[i].data(), packed[i].size());
+        }
+#pragma omp parallel for if (towers > 1)
+        for (uint32_t i = 0; i < towers; i++) {
+            std::vector<uint64_t> words(ringDim);
+            Serial::UnpackBits(packed[i].data(), words.data(), ringDim, moduli[i].GetMSB());
+            for (uint32_t j = 0; j < ringDim; j++)
+                values[i][j] = NativeInteger(words[j]);
+        }
+    }
+
+    for (uint32_t i = 0; i < towers; i++) {
+        for (uint32_t j = 0; j < ringDim; j++) {
+            if (values[i][j] >= moduli[i])
+                OPENFHE_THROW(deserialize_error, "a coefficient of the flat DCRTPoly is not reduced modulo its tower");
+        }
+    }
+
+    m_vectors.clear();
+    m_vectors.reserve(towers);
+    for (uint32_t i = 0; i < towers; i++) {
+        m_vectors.emplace_back(towerParams[i], format);
+        m_vectors.back().SetValues(std::move(values[i]), format);
+    }
+}
+
 template <typename VecType>
 std::ostream& operator<<(std::ostream& os, const DCRTPolyImpl<VecType>& p) {
     // TODO(gryan): Standardize this printing so it is like other poly's
@@ -36,6 +36,7 @@
 #include <cmath>
 #include <fstream>
 #include "lattice/lat-hal.h"
+#include "utils/opcounters.h"
 
 #define DEMANGLER  // used for the demangling type namefunction.
 
@@ -817,6 +818,7 @@ void PolyImpl<VecType>::SwitchFormat() {
     }
 
     if (m_format == Format::COEFFICIENT) {
+        OpCounterScope opCount(OPCOUNT_NTT);
         m_format = Format::EVALUATION;
 
         OPENFHE_DEBUG("transform to Format::EVALUATION m_values was" << *m_values);
@@ -826,6 +828,7 @@ void PolyImpl<VecType>::SwitchFormat() {
         OPENFHE_DEBUG("m_values now in Format::COEFFICIENT " << *m_values);
     }
     else {
+        OpCounterScope opCount(OPCOUNT_INTT);
         m_format = Format::COEFFICIENT;
         OPENFHE_DEBUG("transform to Format::COEFFICIENT m_values was" << *m_values);
 
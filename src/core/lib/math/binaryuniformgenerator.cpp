@@ -50,11 +50,17 @@ typename VecType::Integer BinaryUniformGeneratorImpl<VecType>::GenerateInteger()
 template <typename VecType>
 VecType BinaryUniformGeneratorImpl<VecType>::GenerateVector(const usint size,
                                                             const typename VecType::Integer& modulus) const {
-    VecType v(size);
-    v.SetModulus(modulus);
+    VecType v(size, modulus);
 
-    for (usint i = 0; i < size; i++) {
-        v.at(i) = GenerateInteger();
+    // one bit of bulk PRNG output per entry; each thread draws from its own
+    // threadprivate PRNG stream
+#pragma omp parallel if (PseudoRandomNumberGenerator::ParallelSampling(size))
+    {
+        PRNGBuffer buffer(PseudoRandomNumberGenerator::GetPRNG());
+#pragma omp for schedule(static)
+        for (usint i = 0; i < size; i++) {
+            v[i] = typename VecType::Integer(buffer.NextBits(1));
+        }
     }
     return v;
 }
@@ -206,18 +206,23 @@ std::vector<std::complex<double>> DiscreteFourierTransform::InverseTransform(std
 
 void DiscreteFourierTransform::FFTSpecialInvLazy(std::vector<std::complex<double>>& vals) {
     uint32_t size = vals.size();
+    // the twiddle factors of a stage depend only on j, so they are gathered once per stage
+    // instead of being looked up with a modular reduction in every butterfly
+    std::vector<std::complex<double>> twiddles(size >> 1);
     for (size_t len = size; len >= 1; len >>= 1) {
+        size_t lenh = len >> 1;
+        size_t lenq = len << 2;
+        size_t gap  = m_M / lenq;
+        for (size_t j = 0; j < lenh; ++j)
+            twiddles[j] = m_ksiPows[(lenq - (m_rotGroup[j] % lenq)) * gap];
         for (size_t i = 0; i < size; i += len) {
-            size_t lenh = len >> 1;
-            size_t lenq = len << 2;
-            size_t gap  = m_M / lenq;
+            std::complex<double>* lo = &vals[i];
+            std::complex<double>* hi = lo + lenh;
             for (size_t j = 0; j < lenh; ++j) {
-                size_t idx             = (lenq - (m_rotGroup[j] % lenq)) * gap;
-                std::complex<double> u = vals[i + j] + vals[i + j + lenh];
-                std::complex<double> v = vals[i + j] - vals[i + j + lenh];
-                v *= m_ksiPows[idx];
-                vals[i + j]        = u;
-                vals[i + j + lenh] = v;
+                std::complex<double> u = lo[j] + hi[j];
+                std::complex<double> v = lo[j] - hi[j];
+                lo[j]                  = u;
+                hi[j]                  = v * twiddles[j];
             }
         }
     }
@@ -241,18 +246,21 @@ void DiscreteFourierTransform::FFTSpecial(std::vector<std::complex<double>>& val
         Initialize(m_M, m_M / 4);
     BitReverse(vals);
     uint32_t size = vals.size();
+    std::vector<std::complex<double>> twiddles(size >> 1);
     for (size_t len = 2; len <= size; len <<= 1) {
         size_t lenh = len >> 1;
         size_t lenq = len << 2;
         size_t gap  = m_M / lenq;
+        for (size_t j = 0; j < lenh; ++j)
+            twiddles[j] = m_ksiPows[(m_rotGroup[j] % lenq) * gap];
         for (size_t i = 0; i < size; i += len) {
+            std::complex<double>* lo = &vals[i];
+            std::complex<double>* hi = lo + lenh;
             for (size_t j = 0; j < lenh; ++j) {
-                int64_t idx            = ((m_rotGroup[j] % lenq)) * gap;
-                std::complex<double> u = vals[i + j];
-                std::complex<double> v = vals[i + j + lenh];
-                v *= m_ksiPows[idx];
-                vals[i + j]        = u + v;
-                vals[i + j + lenh] = u - v;
+                std::complex<double> u = lo[j];
+                std::complex<double> v = hi[j] * twiddles[j];
+                lo[j]                  = u + v;
+                hi[j]                  = u - v;
             }
         }
     }
@@ -133,49 +133,68 @@ int32_t DiscreteGaussianGeneratorImpl<VecType>::GenerateInt() const {
 template <typename VecType>
 std::shared_ptr<int64_t> DiscreteGaussianGeneratorImpl<VecType>::GenerateIntVector(usint size) const {
     std::shared_ptr<int64_t> ans(new int64_t[size], std::default_delete<int64_t[]>());
+    int64_t* vals = ans.get();
 
-    int64_t val = 0;
-
-    double seed;
     if (peikert) {
-        std::uniform_real_distribution<double> distribution(0.0, 1.0);
-        for (usint i = 0; i < size; i++) {
-            // we need to use the binary uniform generator rather than regular
-            // continuous distribution; see DG14 for details
-            seed = distribution(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
-            if (std::abs(seed) <= m_a / 2) {
-                val = 0;
+        bool inTable = true;
+        // each thread draws from its own threadprivate PRNG stream
+#pragma omp parallel if (PseudoRandomNumberGenerator::ParallelSampling(size)) reduction(&& : inTable)
+        {
+            PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+#pragma omp for schedule(static)
+            for (usint i = 0; i < size; i++) {
+                inTable = SampleInversion(prng, vals[i]) && inTable;
             }
-            else {
-                if (seed > 0) {
-                    val = FindInVector(m_vals, (std::abs(seed) - m_a / 2));
-                }
-                else {
-                    val = -static_cast<int64_t>(FindInVector(m_vals, (std::abs(seed) - m_a / 2)));
-                }
-            }
-            (ans.get())[i] = val;
         }
+        if (!inTable)
+            OPENFHE_THROW(not_available_error, "DGG Inversion Sampling. Sample outside of the CDF table");
     }
     else {
         for (usint i = 0; i < size; i++) {
-            (ans.get())[i] = GenerateIntegerKarney(0, m_std);
+            vals[i] = GenerateIntegerKarney(0, m_std);
         }
     }
     return ans;
 }
 
 template <typename VecType>
-usint DiscreteGaussianGeneratorImpl<VecType>::FindInVector(const std::vector<double>& S, double search) const {
+usint DiscreteGaussianGeneratorImpl<VecType>::CountBelow(const std::vector<double>& S, double search) {
+    if (S.size() <= CDT_SCAN_THRESHOLD) {
+        // branch-free pass over the whole table
+        usint count = 0;
+        for (size_t i = 0; i < S.size(); i++)
+            count += (S[i] < search);
+        return count;
+    }
     // STL binary search implementation
-    auto lower = std::lower_bound(S.begin(), S.end(), search);
-    if (lower != S.end()) {
-        return lower - S.begin() + 1;
+    return std::lower_bound(S.begin(), S.end(), search) - S.begin();
+}
+
+template <typename VecType>
+usint DiscreteGaussianGeneratorImpl<VecType>::FindInVector(const std::vector<double>& S, double search) const {
+    usint index = CountBelow(S, search);
+    if (index < S.size()) {
+        return index + 1;
     }
     OPENFHE_THROW(not_available_error,
                   "DGG Inversion Sampling. FindInVector value not found: " + std::to_string(search));
 }
 
+template <typename VecType>
+bool DiscreteGaussianGeneratorImpl<VecType>::SampleInversion(PRNG& g, int64_t& sample) const {
+    // we need to use the binary uniform generator rather than regular
+    // continuous distribution; see DG14 for details
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    double seed   = distribution(g) - 0.5;
+    double search = std::abs(seed) - m_a / 2;
+
+    // entries of m_vals are positive, so the count is 0 whenever search <= 0
+    usint index = CountBelow(m_vals, search);
+    int64_t val = static_cast<int64_t>(index) + (search > 0);
+    sample      = (seed > 0) ? val : -val;
+    return index < m_vals.size();
+}
+
 template <typename VecType>
 typename VecType::Integer DiscreteGaussianGeneratorImpl<VecType>::GenerateInteger(
     const typename VecType::Integer& modulus) const {
@@ -210,21 +229,31 @@ typename VecType::Integer DiscreteGaussianGeneratorImpl<VecType>::GenerateIntege
 template <typename VecType>
 VecType DiscreteGaussianGeneratorImpl<VecType>::GenerateVector(const usint size,
                                                                const typename VecType::Integer& modulus) const {
-    std::shared_ptr<int64_t> result = GenerateIntVector(size);
-
-    VecType ans(size);
-    ans.SetModulus(modulus);
+    VecType ans(size, modulus);
 
-    for (usint i = 0; i < size; i++) {
-        int32_t v = (result.get())[i];
-        if (v < 0) {
-            v *= -1;
-            ans[i] = modulus - typename VecType::Integer(v);
+    if (!peikert) {
+        for (usint i = 0; i < size; i++) {
+            int64_t v = GenerateIntegerKarney(0, m_std);
+            ans[i]    = (v < 0) ? modulus - typename VecType::Integer(-v) : typename VecType::Integer(v);
         }
-        else {
-            ans[i] = typename VecType::Integer(v);
+        return ans;
+    }
+
+    // samples are written straight into the vector; each thread draws from
+    // its own threadprivate PRNG stream
+    bool inTable = true;
+#pragma omp parallel if (PseudoRandomNumberGenerator::ParallelSampling(size)) reduction(&& : inTable)
+    {
+        PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+        int64_t v;
+#pragma omp for schedule(static)
+        for (usint i = 0; i < size; i++) {
+            inTable = SampleInversion(prng, v) && inTable;
+            ans[i]  = (v < 0) ? modulus - typename VecType::Integer(-v) : typename VecType::Integer(v);
         }
     }
+    if (!inTable)
+        OPENFHE_THROW(not_available_error, "DGG Inversion Sampling. Sample outside of the CDF table");
 
     return ans;
 }
@@ -34,6 +34,7 @@
   the built-in C++ generator for 32-bit unsigned integers defined in <random>
  */
 
+#include <algorithm>
 #include <bitset>
 #include <sstream>
 
@@ -126,9 +127,57 @@ template <typename VecType>
 VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const usint size) const {
     VecType v(size, m_modulus);
 
+    // the bulk path needs the modulus to fit in a single machine word
+    const usint modulusWidth = m_modulus.GetMSB();
+    const usint wordWidth    = std::min<usint>(64, 8 * sizeof(m_modulus.ConvertToInt()));
+    if (modulusWidth == 0 || modulusWidth > wordWidth) {
+        for (usint i = 0; i < size; i++) {
+            typename VecType::Integer temp(this->GenerateInteger());
+            v.at(i) = temp;
+        }
+        return v;
+    }
+
+    // rejection sampling on modulusWidth-bit chunks of bulk PRNG output; each
+    // thread draws from its own threadprivate PRNG stream
+    const uint64_t q    = static_cast<uint64_t>(m_modulus.ConvertToInt());
+    const uint64_t mask = (modulusWidth == 64) ? ~uint64_t(0) : (uint64_t(1) << modulusWidth) - 1;
+#pragma omp parallel if (PseudoRandomNumberGenerator::ParallelSampling(size))
+    {
+        PRNGBuffer buffer(PseudoRandomNumberGenerator::GetPRNG());
+#pragma omp for schedule(static)
+        for (usint i = 0; i < size; i++) {
+            uint64_t value;
+            do {
+                value = buffer.NextWord() & mask;
+            } while (value >= q);
+            v[i] = typename VecType::Integer(value);
+        }
+    }
+
+    return v;
+}
+
+template <typename VecType>
+VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const usint size, PRNG& prng) const {
+    const usint modulusWidth = m_modulus.GetMSB();
+    const usint wordWidth    = std::min<usint>(64, 8 * sizeof(m_modulus.ConvertToInt()));
+    if (modulusWidth == 0 || modulusWidth > wordWidth)
+        OPENFHE_THROW(math_error, "Sampling from a given PRNG requires a nonzero modulus of at most " +
+                                      std::to_string(wordWidth) + " bits");
+
+    VecType v(size, m_modulus);
+
+    // same rejection sampling as above, but sequential so that the output is reproducible
+    const uint64_t q    = static_cast<uint64_t>(m_modulus.ConvertToInt());
+    const uint64_t mask = (modulusWidth == 64) ? ~uint64_t(0) : (uint64_t(1) << modulusWidth) - 1;
+    PRNGBuffer buffer(prng);
     for (usint i = 0; i < size; i++) {
-        typename VecType::Integer temp(this->GenerateInteger());
-        v.at(i) = temp;
+        uint64_t value;
+        do {
+            value = buffer.NextWord() & mask;
+        } while (value >= q);
+        v[i] = typename VecType::Integer(value);
     }
 
     return v;
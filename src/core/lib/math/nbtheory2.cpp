@@ -38,7 +38,10 @@
 #include <time.h>
 #include <chrono>
 #include <cmath>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <utility>
 
 #include "config_core.h"
 #include "math/distributiongenerator.h"
@@ -318,4 +321,18 @@ void PrecomputeAutoMap(uint32_t n, uint32_t k, std::vector<uint32_t>* precomp) {
     }
 }
 
+const std::vector<uint32_t>& GetAutoMap(uint32_t n, uint32_t k) {
+    // map nodes are never moved, so references stay valid after later insertions
+    static std::map<std::pair<uint32_t, uint32_t>, std::vector<uint32_t>> autoMaps;
+    static std::mutex autoMapsMutex;
+
+    std::lock_guard<std::mutex> lock(autoMapsMutex);
+    auto it = autoMaps.find({n, k});
+    if (it == autoMaps.end()) {
+        it = autoMaps.emplace(std::make_pair(n, k), std::vector<uint32_t>(n)).first;
+        PrecomputeAutoMap(n, k, &it->second);
+    }
+    return it->second;
+}
+
 }  // namespace lbcrypto
@@ -41,26 +41,35 @@
 namespace lbcrypto {
 
 template <typename VecType>
-std::uniform_int_distribution<int> TernaryUniformGeneratorImpl<VecType>::m_distribution =
-    std::uniform_int_distribution<int>(-1, 1);
+int32_t TernaryUniformGeneratorImpl<VecType>::SampleTernary(PRNGBuffer& buffer) {
+    // uniform over {0, 1, 2} by rejecting 3 from 2-bit chunks
+    uint32_t value;
+    do {
+        value = buffer.NextBits(2);
+    } while (value == 3);
+    return static_cast<int32_t>(value) - 1;
+}
 
 template <typename VecType>
 VecType TernaryUniformGeneratorImpl<VecType>::GenerateVector(usint size, const typename VecType::Integer& modulus,
                                                              usint h) const {
-    VecType v(size);
-    v.SetModulus(modulus);
+    VecType v(size, modulus);
 
     if (h == 0) {
-        // regular ternary distribution
-
-        int32_t randomNumber;
-
-        for (usint i = 0; i < size; i++) {
-            randomNumber = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
-            if (randomNumber < 0)
-                v[i] = modulus - typename VecType::Integer(1);
-            else
-                v[i] = typename VecType::Integer(randomNumber);
+        // regular ternary distribution; each thread draws from its own
+        // threadprivate PRNG stream
+        const typename VecType::Integer minusOne(modulus - typename VecType::Integer(1));
+#pragma omp parallel if (PseudoRandomNumberGenerator::ParallelSampling(size))
+        {
+            PRNGBuffer buffer(PseudoRandomNumberGenerator::GetPRNG());
+#pragma omp for schedule(static)
+            for (usint i = 0; i < size; i++) {
+                int32_t randomNumber = SampleTernary(buffer);
+                if (randomNumber < 0)
+                    v[i] = minusOne;
+                else
+                    v[i] = typename VecType::Integer(randomNumber);
+            }
         }
     }
     else {
@@ -108,8 +117,14 @@ std::shared_ptr<int32_t> TernaryUniformGeneratorImpl<VecType>::GenerateIntVector
     std::shared_ptr<int32_t> ans(new int32_t[size], std::default_delete<int32_t[]>());
 
     if (h == 0) {
-        for (usint i = 0; i < size; i++) {
-            (ans.get())[i] = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
+        int32_t* vals = ans.get();
+#pragma omp parallel if (PseudoRandomNumberGenerator::ParallelSampling(size))
+        {
+            PRNGBuffer buffer(PseudoRandomNumberGenerator::GetPRNG());
+#pragma omp for schedule(static)
+            for (usint i = 0; i < size; i++) {
+                vals[i] = SampleTernary(buffer);
+            }
         }
     }
     else {
@@ -0,0 +1,179 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Thread-local counters and optional timers for the hot-path operations
+ */
+
+#include "utils/opcounters.h"
+
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+namespace lbcrypto {
+
+std::atomic<bool> OpCounters::s_timersEnabled{false};
+
+namespace {
+
+// the registry is intentionally leaked so that it outlives the thread_local blocks of all threads
+std::mutex& RegistryMutex() {
+    static auto* m = new std::mutex;
+    return *m;
+}
+
+std::vector<OpCounterBlock*>& Registry() {
+    static auto* r = new std::vector<OpCounterBlock*>;
+    return *r;
+}
+
+// totals of the threads that have already exited
+OpCounterSnapshot& Retired() {
+    static auto* r = new OpCounterSnapshot;
+    return *r;
+}
+
+struct ThreadBlockOwner {
+    OpCounterBlock block;
+
+    ThreadBlockOwner() {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        Registry().push_back(&block);
+    }
+
+    ~ThreadBlockOwner() {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        auto& retired = Retired();
+        for (size_t i = 0; i < OPCOUNT_NUM_TYPES; ++i) {
+            retired.counts[i] += block.counts[i].load(std::memory_order_relaxed);
+            retired.nanoseconds[i] += block.nanoseconds[i].load(std::memory_order_relaxed);
+        }
+        auto& registry = Registry();
+        registry.erase(std::remove(registry.begin(), registry.end(), &block), registry.end());
+    }
+};
+
+}  // namespace
+
+OpCounterBlock* OpCounters::RegisterThreadBlock() {
+    thread_local ThreadBlockOwner owner;
+    return &owner.block;
+}
+
+OpCounterSnapshot OpCounters::GetSnapshot() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    OpCounterSnapshot result = Retired();
+    for (const auto* block : Registry()) {
+        for (size_t i = 0; i < OPCOUNT_NUM_TYPES; ++i) {
+            result.counts[i] += block->counts[i].load(std::memory_order_relaxed);
+            result.nanoseconds[i] += block->nanoseconds[i].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+void OpCounters::Reset() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Retired() = OpCounterSnapshot();
+    for (auto* block : Registry()) {
+        for (size_t i = 0; i < OPCOUNT_NUM_TYPES; ++i) {
+            block->counts[i].store(0, std::memory_order_relaxed);
+            block->nanoseconds[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+OpCounterSnapshot OpCounterSnapshot::operator-(const OpCounterSnapshot& rhs) const {
+    OpCounterSnapshot result;
+    for (size_t i = 0; i < OPCOUNT_NUM_TYPES; ++i) {
+        result.counts[i]      = counts[i] - rhs.counts[i];
+        result.nanoseconds[i] = nanoseconds[i] - rhs.nanoseconds[i];
+    }
+    return result;
+}
+
+std::string OpCounterSnapshot::ToJSON() const {
+    std::stringstream s;
+    s << "{";
+    for (size_t i = 0; i < OPCOUNT_NUM_TYPES; ++i) {
+        if (i > 0)
+            s << ",";
+        s << "\"" << static_cast<OpCounterType>(i) << "\":{\"count\":" << counts[i] << ",\"ns\":" << nanoseconds[i]
+          << "}";
+    }
+    s << "}";
+    return s.str();
+}
+
+std::ostream& operator<<(std::ostream& s, const OpCounterSnapshot& snapshot) {
+    for (size_t i = 0; i < OPCOUNT_NUM_TYPES; ++i) {
+        s << static_cast<OpCounterType>(i) << ": " << snapshot.counts[i];
+        if (snapshot.nanoseconds[i] > 0)
+            s << " (" << snapshot.nanoseconds[i] << " ns)";
+        s << std::endl;
+    }
+    return s;
+}
+
+std::ostream& operator<<(std::ostream& s, OpCounterType op) {
+    switch (op) {
+        case OPCOUNT_NTT:
+            s << "NTT";
+            break;
+        case OPCOUNT_INTT:
+            s << "INTT";
+            break;
+        case OPCOUNT_BASECONV:
+            s << "BaseConversion";
+            break;
+        case OPCOUNT_KEYSWITCH:
+            s << "KeySwitch";
+            break;
+        case OPCOUNT_AUTOMORPHISM:
+            s << "Automorphism";
+            break;
+        case OPCOUNT_RESCALE:
+            s << "Rescale";
+            break;
+        case OPCOUNT_EVALACC:
+            s << "EvalAcc";
+            break;
+        default:
+            s << "UNKNOWN";
+            break;
+    }
+    return s;
+}
+
+}  // namespace lbcrypto
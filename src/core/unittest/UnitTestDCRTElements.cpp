@@ -592,6 +592,60 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+template <typename Element>
+void DCRT_memory_usage(const std::string& msg) {
+    usint m         = 16;
+    usint towersize = 3;
+
+    auto ildcrtparams = std::make_shared<typename Element::Params>(m, towersize, 28);
+
+    Element empty(ildcrtparams, Format::EVALUATION, false);
+    Element zero(ildcrtparams, Format::EVALUATION, true);
+
+    size_t towerBytes = (m / 2) * sizeof(NativeInteger) + sizeof(NativeVector) + sizeof(NativePoly);
+    EXPECT_EQ(zero.GetMemoryUsage(), sizeof(Element) + towersize * towerBytes) << msg;
+    EXPECT_LT(empty.GetMemoryUsage(), zero.GetMemoryUsage()) << msg;
+
+    zero.DropLastElement();
+    EXPECT_EQ(zero.GetMemoryUsage(), sizeof(Element) + (towersize - 1) * towerBytes) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_memory_usage) {
+    RUN_BIG_DCRTPOLYS(DCRT_memory_usage, "DCRT memory usage");
+}
+
+template <typename Element>
+void DCRT_crt_interpolate(const std::string& msg) {
+    usint m         = 16;
+    usint towersize = 4;
+
+    auto ildcrtparams   = std::make_shared<typename Element::Params>(m, towersize, 50);
+    const auto& modulus = ildcrtparams->GetModulus();
+
+    using PolyLarge  = typename Element::PolyLargeType;
+    auto largeParams = std::make_shared<ILParamsImpl<typename Element::Integer>>(m, modulus, 1);
+    typename PolyLarge::DugType dug;
+    PolyLarge large(dug, largeParams, Format::COEFFICIENT);
+    // values at the ends and around the middle of [0, Q)
+    large[0] = 0;
+    large[1] = modulus - typename Element::Integer(1);
+    large[2] = modulus >> 1;
+    large[3] = (modulus >> 1) + typename Element::Integer(1);
+
+    Element element(large, ildcrtparams);
+    EXPECT_TRUE(element.CRTInterpolate() == large) << msg;
+
+    for (PlaintextModulus t : {PlaintextModulus(2), PlaintextModulus(65537), PlaintextModulus(1) << 50})
+        EXPECT_TRUE(element.DecryptionCRTInterpolate(t) == large.DecryptionCRTInterpolate(t)) << msg;
+
+    element.SetFormat(Format::EVALUATION);
+    EXPECT_TRUE(element.CRTInterpolate() == large) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_crt_interpolate) {
+    RUN_BIG_DCRTPOLYS(DCRT_crt_interpolate, "DCRT CRT interpolation");
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
@@ -448,6 +448,29 @@ void DiscreteGaussianGeneratorTest(const std::string& msg) {
         EXPECT_GE(mean, -0.1) << msg << " Failure generate_char_vector_mean_test mean < -0.1";
     }
 
+    // generate_char_vector_variance_test; the CDF table for stdev = 5 is small
+    // enough to be searched by a full scan
+    {
+        int stdev                              = 5;
+        usint size                             = 100000;
+        auto dgg                               = DiscreteGaussianGeneratorImpl<V>(stdev);
+        std::shared_ptr<int64_t> dggCharVector = dgg.GenerateIntVector(size);
+
+        double mean = 0, variance = 0;
+        for (usint i = 0; i < size; i++) {
+            mean += static_cast<double>((dggCharVector.get())[i]);
+        }
+        mean /= size;
+        for (usint i = 0; i < size; i++) {
+            double d = static_cast<double>((dggCharVector.get())[i]) - mean;
+            variance += d * d;
+        }
+        variance /= size;
+
+        EXPECT_NEAR(variance, stdev * stdev, 0.05 * stdev * stdev)
+            << msg << " Failure generate_char_vector_variance_test";
+    }
+
     // generate_vector_mean_test
     {
         int stdev  = 5;
@@ -653,3 +676,27 @@ TEST(UTDistrGen, ThreadSafetyInGetPRNG) {
     RUN_ALL_BACKENDS(ThreadSafetyInGetPRNG, "Thread safety in getPRNG")
 }
 #endif
+
+// Fill must return the same stream as consecutive calls to operator()
+TEST(UTDistrGen, PRNGFill) {
+    std::array<uint32_t, 16> seed{};
+    seed[0] = 1;
+    for (size_t skip : {0, 1, 1023, 1500}) {
+        for (size_t n : {1, 511, 512, 1500}) {
+            PRNG bulk(seed);
+            PRNG single(seed);
+            for (size_t i = 0; i < skip; i++) {
+                bulk();
+                single();
+            }
+            std::vector<uint64_t> words(n);
+            bulk.Fill(words.data(), n);
+            for (size_t i = 0; i < n; i++) {
+                uint64_t lo = single();
+                uint64_t hi = single();
+                ASSERT_EQ(words[i], lo | (hi << 32)) << "Failure in PRNG::Fill at word " << i;
+            }
+            EXPECT_EQ(bulk(), single()) << "PRNG::Fill leaves the engine in a different state";
+        }
+    }
+}
@@ -0,0 +1,97 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code tests the hot-path operation counters
+  */
+
+#include <thread>
+#include "gtest/gtest.h"
+
+#include "lattice/lat-hal.h"
+#include "math/nbtheory.h"
+#include "utils/opcounters.h"
+
+using namespace lbcrypto;
+
+TEST(UTOpCounters, dcrt_switch_format_counts_towers) {
+    usint m     = 16;
+    usint size  = 3;
+    auto params = std::make_shared<DCRTPoly::Params>(m, size, 28);
+
+    DCRTPoly x(params, Format::COEFFICIENT, true);
+
+    OpCounters::Reset();
+    x.SwitchFormat();
+    EXPECT_EQ(OpCounters::GetSnapshot().GetCount(OPCOUNT_NTT), size);
+    EXPECT_EQ(OpCounters::GetSnapshot().GetCount(OPCOUNT_INTT), 0u);
+
+    x.SwitchFormat();
+    auto snapshot = OpCounters::GetSnapshot();
+    EXPECT_EQ(snapshot.GetCount(OPCOUNT_NTT), size);
+    EXPECT_EQ(snapshot.GetCount(OPCOUNT_INTT), size);
+
+    x.AutomorphismTransform(3);
+    EXPECT_EQ((OpCounters::GetSnapshot() - snapshot).GetCount(OPCOUNT_AUTOMORPHISM), 1u);
+
+    OpCounters::Reset();
+    EXPECT_EQ(OpCounters::GetSnapshot().GetCount(OPCOUNT_NTT), 0u);
+}
+
+TEST(UTOpCounters, counts_survive_thread_exit) {
+    OpCounters::Reset();
+    std::thread worker([] { OpCounters::Increment(OPCOUNT_BASECONV, 5); });
+    worker.join();
+    OpCounters::Increment(OPCOUNT_BASECONV);
+    EXPECT_EQ(OpCounters::GetSnapshot().GetCount(OPCOUNT_BASECONV), 6u);
+    OpCounters::Reset();
+}
+
+TEST(UTOpCounters, timers_and_json) {
+    OpCounters::Reset();
+    OpCounters::EnableTimers();
+    {
+        OpCounterScope scope(OPCOUNT_KEYSWITCH, 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    OpCounters::EnableTimers(false);
+
+    auto snapshot = OpCounters::GetSnapshot();
+    EXPECT_EQ(snapshot.GetCount(OPCOUNT_KEYSWITCH), 2u);
+    EXPECT_GE(snapshot.GetNanoseconds(OPCOUNT_KEYSWITCH), 1000000u);
+
+    std::string json = snapshot.ToJSON();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"KeySwitch\":{\"count\":2,"), std::string::npos);
+    EXPECT_NE(json.find("\"NTT\":{\"count\":0,\"ns\":0}"), std::string::npos);
+    OpCounters::Reset();
+}
@@ -41,9 +41,13 @@
 
 #include "metadata.h"
 #include "key/key.h"
+#include "math/distributiongenerator.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <map>
@@ -95,6 +99,7 @@ public:
         encodingType       = ciphertext.encodingType;
         m_slots            = ciphertext.m_slots;
         m_metadataMap      = ciphertext.m_metadataMap;
+        m_elementSeed      = ciphertext.m_elementSeed;
     }
 
     explicit CiphertextImpl(Ciphertext<Element> ciphertext) : CryptoObject<Element>(*ciphertext) {
@@ -107,6 +112,7 @@ public:
         encodingType       = ciphertext->encodingType;
         m_slots            = ciphertext->m_slots;
         m_metadataMap      = ciphertext->m_metadataMap;
+        m_elementSeed      = ciphertext->m_elementSeed;
     }
 
     /**
@@ -122,6 +128,7 @@ public:
         encodingType       = std::move(ciphertext.encodingType);
         m_slots            = std::move(ciphertext.m_slots);
         m_metadataMap      = std::move(ciphertext.m_metadataMap);
+        m_elementSeed      = std::move(ciphertext.m_elementSeed);
     }
 
     explicit CiphertextImpl(Ciphertext<Element>&& ciphertext) : CryptoObject<Element>(*ciphertext) {
@@ -134,6 +141,7 @@ public:
         encodingType       = std::move(ciphertext->encodingType);
         m_slots            = std::move(ciphertext->m_slots);
         m_metadataMap      = std::move(ciphertext->m_metadataMap);
+        m_elementSeed      = std::move(ciphertext->m_elementSeed);
     }
 
     /**
@@ -192,6 +200,7 @@ public:
             this->encodingType       = rhs.encodingType;
             this->m_slots            = rhs.m_slots;
             this->m_metadataMap      = rhs.m_metadataMap;
+            this->m_elementSeed      = rhs.m_elementSeed;
         }
 
         return *this;
@@ -215,6 +224,7 @@ public:
             this->encodingType       = std::move(rhs.encodingType);
             this->m_slots            = std::move(rhs.m_slots);
             this->m_metadataMap      = std::move(rhs.m_metadataMap);
+            this->m_elementSeed      = std::move(rhs.m_elementSeed);
         }
 
         return *this;
@@ -242,6 +252,7 @@ public:
    * @return the first (and only!) ring element
    */
     Element& GetElement() {
+        m_elementSeed.clear();
         if (m_elements.size() == 1)
             return m_elements[0];
 
@@ -263,9 +274,21 @@ public:
    * @return vector of ring elements
    */
     std::vector<Element>& GetElements() {
+        m_elementSeed.clear();
         return m_elements;
     }
 
+    /**
+   * GetMemoryUsage: get the number of bytes held by the ciphertext and its ring elements
+   * @return memory usage in bytes
+   */
+    size_t GetMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& element : m_elements)
+            bytes += element.GetMemoryUsage();
+        return bytes;
+    }
+
     /**
    * SetElement - sets the ring element for the cases that use only one element
    * in the vector this method will throw an exception if it's ever called in
@@ -273,6 +296,7 @@ public:
    * @param &element is a polynomial ring element.
    */
     void SetElement(const Element& element) {
+        m_elementSeed.clear();
         if (m_elements.size() == 0)
             m_elements.push_back(element);
         else if (m_elements.size() == 1)
@@ -290,6 +314,7 @@ public:
    */
     void SetElements(const std::vector<Element>& elements) {
         m_elements = elements;
+        m_elementSeed.clear();
     }
 
     /**
@@ -299,6 +324,26 @@ public:
    */
     void SetElements(std::vector<Element>&& elements) {
         m_elements = std::move(elements);
+        m_elementSeed.clear();
+    }
+
+    /**
+   * Records that the second element is the negation of a uniform polynomial
+   * expanded from seed, as produced by secret-key encryption. Such a
+   * ciphertext is serialized as the seed and its first element only. The seed
+   * is dropped by any non-const access to the elements.
+   *
+   * @param &seed the seed the second element was expanded from.
+   */
+    void SetElementSeed(const PRNGSeed& seed) {
+        m_elementSeed.assign(seed.begin(), seed.end());
+    }
+
+    /**
+   * @return true if the second element can be serialized as a seed
+   */
+    bool HasElementSeed() const {
+        return !m_elementSeed.empty();
     }
 
     /**
@@ -547,7 +592,13 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(cereal::base_class<CryptoObject<Element>>(this));
-        ar(cereal::make_nvp("v", m_elements));
+        // the second element is replaced by its seed
+        bool seeded = HasElementSeed() && m_elements.size() == 2 && m_elements[0].GetFormat() == Format::EVALUATION;
+        ar(cereal::make_nvp("sd", seeded ? m_elementSeed : std::vector<uint32_t>()));
+        if (seeded)
+            ar(cereal::make_nvp("v0", m_elements[0]));
+        else
+            ar(cereal::make_nvp("v", m_elements));
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -565,7 +616,22 @@ public:
                                                  " is from a later version of the library");
         }
         ar(cereal::base_class<CryptoObject<Element>>(this));
-        ar(cereal::make_nvp("v", m_elements));
+        m_elementSeed.clear();
+        if (version > 1)
+            ar(cereal::make_nvp("sd", m_elementSeed));
+        if (m_elementSeed.empty()) {
+            ar(cereal::make_nvp("v", m_elements));
+        }
+        else {
+            if (m_elementSeed.size() != std::tuple_size<PRNGSeed>::value)
+                OPENFHE_THROW(deserialize_error, "the element seed has " + std::to_string(m_elementSeed.size()) +
+                                                     " words instead of " +
+                                                     std::to_string(std::tuple_size<PRNGSeed>::value));
+            Element c0;
+            ar(cereal::make_nvp("v0", c0));
+            Element c1 = ExpandElementSeed(c0);
+            m_elements = {std::move(c0), std::move(c1)};
+        }
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -580,13 +646,29 @@ public:
         return "Ciphertext";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
+    // restores the second element of a fresh secret-key ciphertext from the seed and the first element
+    Element ExpandElementSeed(const Element& c0) const {
+        if constexpr (std::is_constructible<Element, const PRNGSeed&, const std::shared_ptr<typename Element::Params>,
+                                            Format>::value) {
+            PRNGSeed seed{};
+            std::copy(m_elementSeed.begin(), m_elementSeed.end(), seed.begin());
+            return -Element(seed, c0.GetParams(), Format::EVALUATION);
+        }
+        else {
+            OPENFHE_THROW(deserialize_error, "Seeded ciphertexts are only supported for DCRTPoly");
+        }
+    }
+
     // vector of ring elements for this Ciphertext
     std::vector<Element> m_elements;
 
+    // seed the second element was expanded from (a PRNGSeed); empty if the elements are stored as is
+    std::vector<uint32_t> m_elementSeed;
+
     // the degree of the scaling factor for the encrypted message.
     uint32_t m_noiseScaleDeg = 1;
 
@@ -37,6 +37,7 @@
 #define LBCRYPTO_CRYPTO_CRYPTOCONTEXTSER_H
 
 #include "cryptocontext.h"
+#include "scheme/ckksrns/ckksrns-fhe.h"
 
 #include "utils/serial.h"
 
@@ -76,6 +77,30 @@ bool CryptoContextImpl<Element>::SerializeEvalMultKey(std::ostream& ser, const S
     return true;
 }
 
+template <typename Element>
+template <typename ST>
+bool CryptoContextImpl<Element>::SerializeBootstrapPrecom(std::ostream& ser, const ST& sertype, uint32_t slots) const {
+    const auto fhe = std::dynamic_pointer_cast<FHECKKSRNS>(GetScheme()->GetFHE());
+    if (fhe == nullptr)
+        OPENFHE_THROW(config_error, "Bootstrapping precomputations are only supported for CKKS with FHE enabled");
+
+    Serial::Serialize(fhe->GetBootstrapArtifact(*this, slots), ser, sertype);
+    return ser.good();
+}
+
+template <typename Element>
+template <typename ST>
+bool CryptoContextImpl<Element>::DeserializeBootstrapPrecom(std::istream& ser, const ST& sertype) {
+    const auto fhe = std::dynamic_pointer_cast<FHECKKSRNS>(GetScheme()->GetFHE());
+    if (fhe == nullptr)
+        OPENFHE_THROW(config_error, "Bootstrapping precomputations are only supported for CKKS with FHE enabled");
+
+    CKKSBootstrapArtifact artifact;
+    Serial::Deserialize(artifact, ser, sertype);
+    fhe->SetBootstrapArtifact(*this, artifact);
+    return true;
+}
+
 }  // namespace lbcrypto
 
 namespace lbcrypto {
@@ -153,6 +178,11 @@ template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType:
     std::ostream& ser, const SerType::SERJSON&, const CryptoContext<DCRTPoly> cc);
 template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERJSON>(std::istream& ser,
                                                                                             const SerType::SERJSON&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeBootstrapPrecom<SerType::SERJSON>(std::ostream& ser,
+                                                                                      const SerType::SERJSON&,
+                                                                                      uint32_t slots) const;
+template bool CryptoContextImpl<DCRTPoly>::DeserializeBootstrapPrecom<SerType::SERJSON>(std::istream& ser,
+                                                                                        const SerType::SERJSON&);
 
 // ================================= BINARY serialization/deserialization
 namespace Serial {
@@ -229,6 +259,11 @@ template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType:
     std::ostream& ser, const SerType::SERBINARY&, const CryptoContext<DCRTPoly> cc);
 template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERBINARY>(
     std::istream& ser, const SerType::SERBINARY&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeBootstrapPrecom<SerType::SERBINARY>(std::ostream& ser,
+                                                                                        const SerType::SERBINARY&,
+                                                                                        uint32_t slots) const;
+template bool CryptoContextImpl<DCRTPoly>::DeserializeBootstrapPrecom<SerType::SERBINARY>(std::istream& ser,
+                                                                                          const SerType::SERBINARY&);
 
 }  // namespace lbcrypto
 
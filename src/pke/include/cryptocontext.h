@@ -43,21 +43,30 @@
 #include "encoding/plaintextfactory.h"
 
 #include "key/evalkey.h"
+#include "key/evalkeystore.h"
 #include "key/keypair.h"
 
+#include "lineartransform.h"
+
 #include "schemebase/base-pke.h"
 #include "schemerns/rns-cryptoparameters.h"
 
 #include "utils/caller_info.h"
+#include "utils/opcounters.h"
 #include "utils/serial.h"
 
+#include <complex>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 
 namespace lbcrypto {
 
@@ -283,10 +292,112 @@ protected:
         return s_evalAutomorphismKeyMap;
     }
 
+    // automorphism key loaded from the key store; only these are ever evicted
+    struct StoredEvalKey {
+        std::string keyTag;
+        usint index;
+        const EvalKeyImpl<Element>* key;
+        size_t bytes;
+    };
+
+    struct EvalKeyStoreState {
+        std::shared_ptr<EvalKeyStore<Element>> store;
+        // set together with store, so that operations skip the lock when no store is configured
+        std::atomic<bool> hasStore{false};
+        // 0 means no limit
+        size_t budget = 0;
+        size_t bytes  = 0;
+        // most recently used first
+        std::list<StoredEvalKey> lru;
+        std::map<std::pair<std::string, usint>, typename std::list<StoredEvalKey>::iterator> loaded;
+        std::mutex mutex;
+
+        void Forget(typename std::list<StoredEvalKey>::iterator it) {
+            bytes -= it->bytes;
+            loaded.erase({it->keyTag, it->index});
+            lru.erase(it);
+        }
+
+        void Forget(const std::string& keyTag) {
+            for (auto it = lru.begin(); it != lru.end();) {
+                auto next = std::next(it);
+                if (it->keyTag == keyTag)
+                    Forget(it);
+                it = next;
+            }
+        }
+    };
+
+    static EvalKeyStoreState& evalKeyStore() {
+        // store missing automorphism keys are loaded from, shared like the key maps above
+        static EvalKeyStoreState s_evalKeyStore;
+        return s_evalKeyStore;
+    }
+
+    /**
+   * Loads the automorphism keys for the given rotation indices from the key store, if one is set
+   * @param keyTag tag of the secret key
+   * @param indices rotation indices
+   */
+    void LoadEvalRotationKeys(const std::string& keyTag, const std::vector<int32_t>& indices) const;
+
+    /**
+   * Returns slots, or the number of slots of the context (the batch size if set, otherwise half the ring
+   * dimension) if slots is 0
+   */
+    uint32_t GetDefaultSlots(uint32_t slots) const;
+
+    // kinds of keys held by a flat key bundle
+    enum FlatKeyBundle : uint32_t { FLAT_BUNDLE_EVALMULT = 0, FLAT_BUNDLE_AUTOMORPHISM = 1 };
+
+    void SerializeEvalKeyBundleFlat(std::ostream& os, FlatKeyBundle kind, const std::string& keyTag,
+                                    const std::vector<std::pair<usint, EvalKey<Element>>>& keys) const;
+
+    /**
+   * Reads a flat key bundle and passes every decoded key to insert, in the order of the stream
+   * @return number of keys passed to insert
+   */
+    size_t DeserializeEvalKeyBundleFlat(
+        std::istream& is, FlatKeyBundle kind, const std::function<bool(usint)>& filter,
+        const std::function<void(const std::string&, usint, EvalKey<Element>)>& insert) const;
+
     SCHEME m_schemeId = SCHEME::INVALID_SCHEME;
 
     uint32_t m_keyGenLevel;
 
+    // CKKS plaintexts re-encoded at the level and depth of the ciphertexts they were used with,
+    // most recently used first
+    struct CachedPlaintext {
+        std::tuple<size_t, uint32_t, size_t, usint> key;
+        std::vector<std::complex<double>> value;
+        ConstPlaintext plaintext;
+        size_t bytes;
+    };
+    mutable std::list<CachedPlaintext> m_ptxtCache;
+    mutable std::map<std::tuple<size_t, uint32_t, size_t, usint>, typename std::list<CachedPlaintext>::iterator>
+        m_ptxtCacheIndex;
+    mutable std::mutex m_ptxtCacheMutex;
+    mutable size_t m_ptxtCacheBytes = 0;
+    // read without the lock, so that plaintext operations skip it while the cache is disabled
+    std::atomic<size_t> m_ptxtCacheBudget{0};
+
+    // EvalMult and EvalSquare leave their results unrelinearized (see SetLazyRelinearization)
+    bool m_lazyRelin = false;
+
+    /**
+   * Returns the plaintext to use with the given ciphertext: a copy of a CKKS plaintext encoded directly at
+   * the level and depth the scheme would otherwise adjust it to, taken from the plaintext cache, or the
+   * plaintext itself if the cache is disabled or no adjustment is needed
+   * @param ciphertext ciphertext the plaintext is used with
+   * @param plaintext input plaintext
+   * @param forMult true for EvalMult, false for EvalAdd
+   */
+    ConstPlaintext GetCachedPlaintext(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext,
+                                      bool forMult) const;
+
+    // drops the least recently used plaintexts until the cache fits its budget; the lock must be held
+    void TrimPlaintextCache() const;
+
     /**
    * TypeCheck makes sure that an operation between two ciphertexts is permitted
    * @param a
@@ -490,10 +601,12 @@ public:
    * @param c - source
    */
     CryptoContextImpl(const CryptoContextImpl<Element>& c) {
-        params              = c.params;
-        scheme              = c.scheme;
-        this->m_keyGenLevel = 0;
-        this->m_schemeId    = c.m_schemeId;
+        params                  = c.params;
+        scheme                  = c.scheme;
+        this->m_keyGenLevel     = 0;
+        this->m_schemeId        = c.m_schemeId;
+        this->m_ptxtCacheBudget = c.m_ptxtCacheBudget.load();
+        this->m_lazyRelin       = c.m_lazyRelin;
     }
 
     /**
@@ -506,6 +619,10 @@ public:
         scheme        = rhs.scheme;
         m_keyGenLevel = rhs.m_keyGenLevel;
         m_schemeId    = rhs.m_schemeId;
+        m_lazyRelin   = rhs.m_lazyRelin;
+        // the cached plaintexts were encoded for the old parameters
+        SetPlaintextCacheBudget(0);
+        SetPlaintextCacheBudget(rhs.m_ptxtCacheBudget.load());
         return *this;
     }
 
@@ -555,6 +672,101 @@ public:
         return !(a == b);
     }
 
+    /**
+   * Writes a ciphertext in the flat binary format: a small header (element count, level, scaling data, key tag)
+   * followed by the elements, each as a header (ring dimension, towers, moduli, format) and the raw coefficient
+   * arrays of its towers. Neither the context nor the parameters are written, so the ciphertext is read back
+   * with DeserializeCiphertextFlat of a context with the same parameters. The metadata map is not written.
+   *
+   * @param ciphertext the ciphertext to write
+   * @param os the output stream
+   * @param bitPacked true to pack the coefficients of each tower to the bit width of its modulus
+   */
+    void SerializeFlat(ConstCiphertext<Element> ciphertext, std::ostream& os, bool bitPacked = false) const;
+
+    /**
+   * Writes a ciphertext for storage or for transport to the party that decrypts it: the flat binary format
+   * with the coefficients bit-packed to the width of their moduli, optionally after dropping to towersLeft
+   * towers with Compress. A 40-bit tower then takes 5 bytes per coefficient instead of 8. The ciphertext is
+   * read back with DeserializeCiphertextFlat.
+   *
+   * There is no further entropy coding stage: the coefficients of a ciphertext are uniformly distributed
+   * modulo their towers, so general-purpose compressors do not shrink them below the packed size.
+   *
+   * @param ciphertext the ciphertext to write
+   * @param os the output stream
+   * @param towersLeft number of towers to keep (see Compress); 0 keeps all of them
+   */
+    void SerializeCompressed(ConstCiphertext<Element> ciphertext, std::ostream& os, uint32_t towersLeft = 0) const;
+
+    /**
+   * Reads a ciphertext written by SerializeFlat or SerializeCompressed; the coefficients are read straight into
+   * the new elements
+   *
+   * @param is the input stream
+   * @return the ciphertext, in this context
+   */
+    Ciphertext<Element> DeserializeCiphertextFlat(std::istream& is) const;
+
+    /**
+   * Writes a relinearization or automorphism key in the flat binary format. A key with a seeded vector A
+   * is written as the seed and vector B only.
+   *
+   * @param evalKey the key to write
+   * @param os the output stream
+   */
+    void SerializeFlat(const EvalKey<Element> evalKey, std::ostream& os) const;
+
+    /**
+   * Reads a key written by SerializeFlat. The key is not inserted into any key map.
+   *
+   * @param is the input stream
+   * @return the key, in this context
+   */
+    EvalKey<Element> DeserializeEvalKeyFlat(std::istream& is) const;
+
+    /**
+   * Writes the EvalMult keys of a secret key as a flat key bundle: a header (key tag, key count) followed by
+   * one record per key, each holding its index, its size in bytes and the key in the flat format
+   *
+   * @param os the output stream
+   * @param keyTag tag of the secret key
+   * @return true on success (false if there are no keys for keyTag)
+   */
+    bool SerializeEvalMultKeyFlat(std::ostream& os, const std::string& keyTag) const;
+
+    /**
+   * Writes the automorphism keys of a secret key as a flat key bundle (see SerializeEvalMultKeyFlat)
+   *
+   * @param os the output stream
+   * @param keyTag tag of the secret key
+   * @return true on success (false if there are no keys for keyTag)
+   */
+    bool SerializeEvalAutomorphismKeyFlat(std::ostream& os, const std::string& keyTag) const;
+
+    /**
+   * Reads a bundle written by SerializeEvalMultKeyFlat and replaces the EvalMult keys of its key tag.
+   * Records are read and decoded a batch at a time, so no second copy of the whole key set is held.
+   *
+   * @param is the input stream
+   * @return number of keys read
+   */
+    size_t DeserializeEvalMultKeyFlat(std::istream& is) const;
+
+    /**
+   * Reads a bundle written by SerializeEvalAutomorphismKeyFlat into the EvalAutomorphismKey cache; the keys
+   * replace any existing keys with the same index. Records are read a batch at a time, the keys of a batch are
+   * decoded in parallel and inserted before the next batch is read, so the peak memory stays close to the size
+   * of the keys kept. The stream can be a std::ifstream, and does not need to be seekable.
+   *
+   * @param is the input stream
+   * @param filter returns whether to keep the key for an automorphism index; the other keys are skipped
+   * without being decoded. nullptr keeps all keys
+   * @return number of keys inserted
+   */
+    size_t DeserializeEvalAutomorphismKeyFlat(std::istream& is,
+                                              const std::function<bool(usint)>& filter = nullptr) const;
+
     /**
    * SerializeEvalMultKey for a single EvalMult key or all EvalMult keys
    *
@@ -844,6 +1056,39 @@ public:
    */
     static void InsertEvalAutomorphismKey(const std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap);
 
+    /**
+   * SetEvalKeyStore - sets a store automorphism keys missing from the
+   * EvalAutomorphismKey cache are loaded from on first use. Rotations,
+   * EvalLinearTransform and EvalBootstrap then fetch the keys they need
+   * transparently. Keys loaded from the store are evicted least recently used
+   * first once they occupy more than the budget; the keys needed by a single
+   * operation are kept even if they exceed it. Keys generated or inserted
+   * directly are never evicted.
+   *
+   * Loading a key modifies the EvalAutomorphismKey cache, so keys rotated by
+   * from several threads at once should be prefetched with
+   * LoadEvalAutomorphismKeys first.
+   *
+   * @param store the key store; nullptr stops loading keys
+   * @param budget bytes the keys loaded from the store may occupy; 0 means no limit
+   */
+    static void SetEvalKeyStore(std::shared_ptr<EvalKeyStore<Element>> store, size_t budget = 0);
+
+    /**
+   * GetEvalKeyStore - returns the store set by SetEvalKeyStore
+   * @return the key store or nullptr
+   */
+    static std::shared_ptr<EvalKeyStore<Element>> GetEvalKeyStore();
+
+    /**
+   * LoadEvalAutomorphismKeys - loads the given automorphism keys from the key
+   * store unless they are in the EvalAutomorphismKey cache already; can be
+   * used to prefetch the keys of upcoming operations
+   * @param keyTag tag of the secret key
+   * @param indexList automorphism indices
+   */
+    static void LoadEvalAutomorphismKeys(const std::string& keyTag, const std::vector<usint>& indexList);
+
     //------------------------------------------------------------------------------
     // TURN FEATURES ON
     //------------------------------------------------------------------------------
@@ -941,6 +1186,50 @@ public:
         return params->GetElementParams()->GetRootOfUnity();
     }
 
+    //------------------------------------------------------------------------------
+    // OPERATION COUNTERS
+    //------------------------------------------------------------------------------
+
+    /**
+   * Returns the hot-path operation counters (and timers, if enabled) summed over all threads.
+   * The counters are process-wide, so the snapshot covers all contexts.
+   *
+   * @return snapshot of the counters; use ToJSON() to export it
+   */
+    static OpCounterSnapshot GetOpCounters() {
+        return OpCounters::GetSnapshot();
+    }
+
+    /**
+   * Resets the hot-path operation counters and timers of all threads
+   */
+    static void ResetOpCounters() {
+        OpCounters::Reset();
+    }
+
+    /**
+   * Turns the scoped timers of the hot-path operations on or off (they are off by default)
+   *
+   * @param enable true to collect timing information
+   */
+    static void EnableOpTimers(bool enable = true) {
+        OpCounters::EnableTimers(enable);
+    }
+
+    //------------------------------------------------------------------------------
+    // MEMORY USAGE
+    //------------------------------------------------------------------------------
+
+    /**
+   * Reports the memory held on behalf of this context, in bytes, by category:
+   * "EvalMultKeys", "EvalSumKeys" and "EvalAutomorphismKeys" (the keys of this context in the
+   * global key maps), "FHEPrecomputations" (e.g. CKKS bootstrapping plaintexts), "PlaintextCache"
+   * (see SetPlaintextCacheBudget) and "NTTTables" (the root-of-unity tables, which are shared by all contexts)
+   *
+   * @return map from category to the number of bytes
+   */
+    std::map<std::string, size_t> GetMemoryUsage() const;
+
     //------------------------------------------------------------------------------
     // KEYS GETTERS
     //------------------------------------------------------------------------------
@@ -1046,6 +1335,21 @@ public:
         return MakeCKKSPackedPlaintextInternal(complexValue, depth, level, params, slots);
     }
 
+    /**
+   * MakeCKKSPackedPlaintexts constructs a batch of CKKSPackedEncodings in this context
+   * from vectors of real numbers. The plaintexts are encoded in parallel and share
+   * the depth, level, parameters and number of slots
+   * @param values - input vectors
+   * @param depth - depth used to encode the vectors
+   * @param level - level at which the vectors will get encrypted
+   * @param params - parameters to be used for the ciphertexts
+   * @param slots - number of slots
+   * @return plaintexts in the order of values
+   */
+    std::vector<Plaintext> MakeCKKSPackedPlaintexts(const std::vector<std::vector<double>>& values, size_t depth = 1,
+                                                    uint32_t level = 0, const std::shared_ptr<ParmType> params = nullptr,
+                                                    usint slots = 0) const;
+
     /**
    * GetPlaintextForDecrypt returns a new Plaintext to be used in decryption.
    *
@@ -1151,6 +1455,18 @@ public:
         return Decrypt(ciphertext, privateKey, plaintext);
     }
 
+    /**
+   * Decrypt a batch of ciphertexts into the appropriate plaintexts. The ciphertexts are
+   * decrypted and decoded in parallel
+   *
+   * @param ciphertexts - ciphertexts to decrypt
+   * @param privateKey - decryption key
+   * @param plaintexts - resulting plaintexts, in the order of ciphertexts
+   * @return one result per ciphertext
+   */
+    std::vector<DecryptResult> Decrypt(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                       const PrivateKey<Element> privateKey, std::vector<Plaintext>* plaintexts);
+
     //------------------------------------------------------------------------------
     // KeySwitch Wrapper
     //------------------------------------------------------------------------------
@@ -1180,7 +1496,7 @@ public:
         CheckCiphertext(ciphertext);
         CheckKey(evalKey);
 
-        return GetScheme()->KeySwitch(ciphertext, evalKey);
+        return GetScheme()->KeySwitch(RelinearizeLazy(ciphertext), evalKey);
     }
 
     /**
@@ -1192,6 +1508,7 @@ public:
         CheckCiphertext(ciphertext);
         CheckKey(evalKey);
 
+        RelinearizeLazyInPlace(ciphertext);
         GetScheme()->KeySwitchInPlace(ciphertext, evalKey);
     }
 
@@ -1264,7 +1581,7 @@ public:
     Ciphertext<Element> EvalAdd(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
         TypeCheck(ciphertext, plaintext);
         plaintext->SetFormat(EVALUATION);
-        return GetScheme()->EvalAdd(ciphertext, plaintext);
+        return GetScheme()->EvalAdd(ciphertext, GetCachedPlaintext(ciphertext, plaintext, false));
     }
 
     Ciphertext<Element> EvalAdd(ConstPlaintext plaintext, ConstCiphertext<Element> ciphertext) const {
@@ -1274,7 +1591,7 @@ public:
     void EvalAddInPlace(Ciphertext<Element>& ciphertext, ConstPlaintext plaintext) const {
         TypeCheck(ciphertext, plaintext);
         plaintext->SetFormat(EVALUATION);
-        GetScheme()->EvalAddInPlace(ciphertext, plaintext);
+        GetScheme()->EvalAddInPlace(ciphertext, GetCachedPlaintext(ciphertext, plaintext, false));
     }
 
     void EvalAddInPlace(ConstPlaintext plaintext, Ciphertext<Element>& ciphertext) const {
@@ -1507,7 +1824,13 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->EvalMult(ciphertext1, ciphertext2, evalKeyVec[0]);
+        // operands left unrelinearized by lazy products are relinearized here, as late as possible
+        auto ct1 = RelinearizeLazy(ciphertext1);
+        auto ct2 = RelinearizeLazy(ciphertext2);
+        if (m_lazyRelin)
+            return GetScheme()->EvalMult(ct1, ct2);
+
+        return GetScheme()->EvalMult(ct1, ct2, evalKeyVec[0]);
     }
 
     /**
@@ -1527,6 +1850,8 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMultMutable");
         }
 
+        RelinearizeLazyInPlace(ciphertext1);
+        RelinearizeLazyInPlace(ciphertext2);
         return GetScheme()->EvalMultMutable(ciphertext1, ciphertext2, evalKeyVec[0]);
     }
 
@@ -1547,6 +1872,8 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMultMutable");
         }
 
+        RelinearizeLazyInPlace(ciphertext1);
+        RelinearizeLazyInPlace(ciphertext2);
         GetScheme()->EvalMultMutableInPlace(ciphertext1, ciphertext2, evalKeyVec[0]);
     }
 
@@ -1558,7 +1885,11 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->EvalSquare(ciphertext, evalKeyVec[0]);
+        auto ct = RelinearizeLazy(ciphertext);
+        if (m_lazyRelin)
+            return GetScheme()->EvalSquare(ct);
+
+        return GetScheme()->EvalSquare(ct, evalKeyVec[0]);
     }
 
     Ciphertext<Element> EvalSquareMutable(Ciphertext<Element>& ciphertext) const {
@@ -1569,6 +1900,7 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMultMutable");
         }
 
+        RelinearizeLazyInPlace(ciphertext);
         return GetScheme()->EvalSquareMutable(ciphertext, evalKeyVec[0]);
     }
 
@@ -1580,9 +1912,60 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMultMutable");
         }
 
+        if (m_lazyRelin) {
+            ciphertext = GetScheme()->EvalSquare(RelinearizeLazy(ciphertext));
+            return;
+        }
+        RelinearizeLazyInPlace(ciphertext);
+
         GetScheme()->EvalSquareInPlace(ciphertext, evalKeyVec[0]);
     }
 
+    /**
+   * Turns on lazy relinearization: EvalMult and EvalSquare of two ciphertexts return the product without
+   * relinearizing it, and EvalAdd/EvalSub/constant and plaintext multiplications keep the extra element. A
+   * ciphertext with more than two elements is relinearized only when it reaches an operation that needs two:
+   * another ciphertext product (including the mutable variants and EvalMultMany), a rotation, EvalSum,
+   * EvalInnerProduct, EvalMerge or other key switch, polynomial and Chebyshev evaluation, multiparty decryption
+   * or bootstrapping. A sum of products is thus relinearized once instead of once per product. Decrypt accepts
+   * unrelinearized ciphertexts. Applies to BFV, BGV and CKKS alike. With FIXEDAUTO/FLEXIBLEAUTO the rescaling
+   * is already deferred to the next multiplication. Requires the keys of EvalMultKeyGen; off by default.
+   *
+   * @param lazy true to defer relinearization
+   */
+    void SetLazyRelinearization(bool lazy) {
+        m_lazyRelin = lazy;
+    }
+
+    /**
+   * @return true if EvalMult and EvalSquare defer relinearization (see SetLazyRelinearization)
+   */
+    bool GetLazyRelinearization() const {
+        return m_lazyRelin;
+    }
+
+    /**
+   * Relinearizes a ciphertext only if it has more than two elements
+   *
+   * @param ciphertext input ciphertext.
+   * @return the relinearized ciphertext, or the input if it already has two elements
+   */
+    ConstCiphertext<Element> RelinearizeLazy(ConstCiphertext<Element> ciphertext) const {
+        if (ciphertext->GetElements().size() <= 2)
+            return ciphertext;
+        return Relinearize(ciphertext);
+    }
+
+    /**
+   * In-place version of RelinearizeLazy
+   *
+   * @param ciphertext input ciphertext, relinearized if it has more than two elements
+   */
+    void RelinearizeLazyInPlace(Ciphertext<Element>& ciphertext) const {
+        if (ciphertext->GetElements().size() > 2)
+            RelinearizeInPlace(ciphertext);
+    }
+
     /**
    * EvalMult - OpenFHE EvalMult method for a pair of ciphertexts - no key
    * switching (relinearization)
@@ -1660,18 +2043,26 @@ public:
 
         const auto evalKeyVec = GetEvalMultKeyVector(ciphertext1->GetKeyTag());
 
-        if (evalKeyVec.size() < (ciphertext1->GetElements().size() + ciphertext2->GetElements().size() - 3)) {
+        // lazy products the keys cannot take to the combined degree are relinearized first
+        auto ct1 = ciphertext1;
+        auto ct2 = ciphertext2;
+        if (evalKeyVec.size() < (ct1->GetElements().size() + ct2->GetElements().size() - 3)) {
+            ct1 = RelinearizeLazy(ct1);
+            ct2 = RelinearizeLazy(ct2);
+        }
+
+        if (evalKeyVec.size() < (ct1->GetElements().size() + ct2->GetElements().size() - 3)) {
             OPENFHE_THROW(type_error,
                           "Insufficient value was used for maxRelinSkDeg to generate "
                           "keys for EvalMult");
         }
 
-        return GetScheme()->EvalMultAndRelinearize(ciphertext1, ciphertext2, evalKeyVec);
+        return GetScheme()->EvalMultAndRelinearize(ct1, ct2, evalKeyVec);
     }
 
     Ciphertext<Element> EvalMult(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
         TypeCheck(ciphertext, plaintext);
-        return GetScheme()->EvalMult(ciphertext, plaintext);
+        return GetScheme()->EvalMult(ciphertext, GetCachedPlaintext(ciphertext, plaintext, true));
     }
 
     Ciphertext<Element> EvalMult(ConstPlaintext plaintext, ConstCiphertext<Element> ciphertext) const {
@@ -1811,7 +2202,7 @@ public:
 
         CheckKey(evalKey);
 
-        return GetScheme()->EvalAutomorphism(ciphertext, i, evalKeyMap);
+        return GetScheme()->EvalAutomorphism(RelinearizeLazy(ciphertext), i, evalKeyMap);
     }
 
     usint FindAutomorphismIndex(const usint idx) const {
@@ -1833,8 +2224,9 @@ public:
     Ciphertext<Element> EvalRotate(ConstCiphertext<Element> ciphertext, int32_t index) const {
         CheckCiphertext(ciphertext);
 
-        auto evalKeyMap = GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-        return GetScheme()->EvalAtIndex(ciphertext, index, evalKeyMap);
+        LoadEvalRotationKeys(ciphertext->GetKeyTag(), {index});
+        const auto& evalKeyMap = GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+        return GetScheme()->EvalAtIndex(RelinearizeLazy(ciphertext), index, evalKeyMap);
     }
 
     /**
@@ -1862,9 +2254,11 @@ public:
    * hoisted automorphisms.
    *
    * @param ct the input ciphertext on which to do the precomputation (digit
-   * decomposition)
+   * decomposition). It has to be relinearized (see RelinearizeLazy).
    */
     std::shared_ptr<std::vector<Element>> EvalFastRotationPrecompute(ConstCiphertext<Element> ciphertext) const {
+        if (ciphertext->GetElements().size() > 2)
+            OPENFHE_THROW(config_error, "EvalFastRotationPrecompute requires a relinearized ciphertext");
         return GetScheme()->EvalFastRotationPrecompute(ciphertext);
     }
 
@@ -1906,6 +2300,7 @@ public:
    */
     Ciphertext<Element> EvalFastRotation(ConstCiphertext<Element> ciphertext, const usint index, const usint m,
                                          const std::shared_ptr<std::vector<Element>> digits) const {
+        LoadEvalRotationKeys(ciphertext->GetKeyTag(), {static_cast<int32_t>(index)});
         return GetScheme()->EvalFastRotation(ciphertext, index, m, digits);
     }
 
@@ -1922,11 +2317,91 @@ public:
    */
     Ciphertext<Element> EvalFastRotationExt(ConstCiphertext<Element> ciphertext, usint index,
                                             const std::shared_ptr<std::vector<Element>> digits, bool addFirst) const {
-        auto evalKeyMap = GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+        LoadEvalRotationKeys(ciphertext->GetKeyTag(), {static_cast<int32_t>(index)});
+        const auto& evalKeyMap = GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
 
         return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeyMap);
     }
 
+    /**
+   * Rotates a ciphertext by several indices at once using hoisted automorphisms.
+   * The digit decomposition is computed once and shared by all rotations, and
+   * the per-index key switches run in parallel.
+   *
+   * @param ciphertext input ciphertext
+   * @param indices the rotation indices. Positive indices correspond to left
+   * rotations and negative indices correspond to right rotations.
+   * @param extended if true, the results are left in the extended CRT basis P*Q
+   * (only supported for hybrid key switching); use KeySwitchDown to scale them back
+   * @return the rotated ciphertexts, in the order of indices
+   */
+    std::vector<Ciphertext<Element>> EvalRotateMany(ConstCiphertext<Element> ciphertext,
+                                                    const std::vector<int32_t>& indices, bool extended = false) const;
+
+    /**
+   * Prepares a real rows x cols plaintext matrix for EvalLinearTransform (CKKS only).
+   * The matrix is zero-padded to the smallest power-of-two dimension dim >= max(rows, cols),
+   * stored by its nonzero diagonals and split into baby and giant steps. The rotation keys
+   * returned by GetRotationIndices() of the result have to be generated before evaluation.
+   *
+   * @param A the matrix
+   * @param slots number of slots of the input ciphertexts; 0 selects the batch size
+   * @param bStep baby-step dimension; 0 selects the one minimizing the number of rotations
+   * @return the precomputed transform; its encoded diagonals are cached per level
+   */
+    std::shared_ptr<LinearTransformPrecom> EvalLinearTransformPrecompute(const std::vector<std::vector<double>>& A,
+                                                                         uint32_t slots = 0, uint32_t bStep = 0) const;
+
+    /**
+   * Prepares a dim x dim plaintext matrix given by its diagonals for EvalLinearTransform
+   * (CKKS only). Diagonal k holds the entries A[i][(i + k) mod dim]; missing diagonals are zero.
+   *
+   * @param dim the power-of-two matrix dimension
+   * @param diagonals map from diagonal index to its dim entries
+   * @param slots number of slots of the input ciphertexts; 0 selects the batch size
+   * @param bStep baby-step dimension; 0 selects the one minimizing the number of rotations
+   * @return the precomputed transform; its encoded diagonals are cached per level
+   */
+    std::shared_ptr<LinearTransformPrecom> EvalLinearTransformPrecompute(
+        uint32_t dim, const std::map<uint32_t, std::vector<double>>& diagonals, uint32_t slots = 0,
+        uint32_t bStep = 0) const;
+
+    /**
+   * Computes A * x for a plaintext matrix A and an encrypted vector x using the
+   * baby-step giant-step diagonal method with hoisted baby-step rotations.
+   * x is expected in the first cols slots with zeros in the remaining slots; the
+   * result is in the first rows slots with zeros elsewhere. Consumes one level.
+   *
+   * @param precom the matrix prepared by EvalLinearTransformPrecompute
+   * @param ciphertext the encrypted vector
+   * @return the encrypted product
+   */
+    Ciphertext<Element> EvalLinearTransform(const std::shared_ptr<LinearTransformPrecom>& precom,
+                                            ConstCiphertext<Element> ciphertext) const;
+
+    /**
+   * Prepares the product of two encrypted d x d matrices (CKKS only). The rotation keys
+   * returned by GetRotationIndices() of the result, and the relinearization key, have to
+   * be generated before evaluation.
+   *
+   * @param d the power-of-two matrix dimension; d * d cannot exceed the number of slots
+   * @param slots number of slots of the input ciphertexts; 0 selects the batch size
+   * @return the precomputed permutations
+   */
+    std::shared_ptr<MatMulPrecom> EvalMatMulPrecompute(uint32_t d, uint32_t slots = 0) const;
+
+    /**
+   * Computes A * B for encrypted d x d matrices packed row by row into the first d * d
+   * slots (zeros elsewhere). Consumes three levels.
+   *
+   * @param precom the permutations prepared by EvalMatMulPrecompute
+   * @param ciphertext1 the encrypted matrix A
+   * @param ciphertext2 the encrypted matrix B
+   * @return the encrypted product, packed the same way
+   */
+    Ciphertext<Element> EvalMatMul(const std::shared_ptr<MatMulPrecom>& precom, ConstCiphertext<Element> ciphertext1,
+                                   ConstCiphertext<Element> ciphertext2) const;
+
     /**
    * Only supported for hybrid key switching.
    * Takes a ciphertext in the extended basis P*Q
@@ -2014,7 +2489,7 @@ public:
             OPENFHE_THROW(type_error, "Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->ComposedEvalMult(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->ComposedEvalMult(RelinearizeLazy(ciphertext1), RelinearizeLazy(ciphertext2), evalKeyVec[0]);
     }
 
     /**
@@ -2143,8 +2618,10 @@ public:
     /**
    * EvalMultMany - OpenFHE function for evaluating multiplication on
    * ciphertext followed by relinearization operation (at the end). It computes
-   * the multiplication in a binary tree manner. Also, it reduces the number of
-   * elements in the ciphertext to two after each multiplication.
+   * the multiplication in a binary tree manner, pairing the operands of the
+   * smallest depth first and running the products of a tree level in parallel.
+   * Also, it reduces the number of elements in the ciphertext to two after each
+   * multiplication.
    * Currently it assumes that the consecutive two input arguments have
    * total depth smaller than the supported depth. Otherwise, it throws an
    * error.
@@ -2168,7 +2645,14 @@ public:
             OPENFHE_THROW(type_error, "Insufficient value was used for maxRelinSkDeg to generate keys");
         }
 
-        return GetScheme()->EvalMultMany(ciphertextVec, evalKeyVec);
+        // the product tree expects two-element operands
+        std::vector<Ciphertext<Element>> operands(ciphertextVec);
+        for (auto& operand : operands) {
+            if (operand->GetElements().size() > 2)
+                operand = Relinearize(operand);
+        }
+
+        return GetScheme()->EvalMultMany(operands, evalKeyVec);
     }
 
     //------------------------------------------------------------------------------
@@ -2229,7 +2713,7 @@ public:
                                          const std::vector<double>& coefficients) const {
         CheckCiphertext(ciphertext);
 
-        return GetScheme()->EvalPoly(ciphertext, coefficients);
+        return GetScheme()->EvalPoly(RelinearizeLazy(ciphertext), coefficients);
     }
 
     /**
@@ -2246,13 +2730,13 @@ public:
                                        const std::vector<double>& coefficients) const {
         CheckCiphertext(ciphertext);
 
-        return GetScheme()->EvalPolyLinear(ciphertext, coefficients);
+        return GetScheme()->EvalPolyLinear(RelinearizeLazy(ciphertext), coefficients);
     }
 
     Ciphertext<Element> EvalPolyPS(ConstCiphertext<Element> ciphertext, const std::vector<double>& coefficients) const {
         CheckCiphertext(ciphertext);
 
-        return GetScheme()->EvalPolyPS(ciphertext, coefficients);
+        return GetScheme()->EvalPolyPS(RelinearizeLazy(ciphertext), coefficients);
     }
 
     //------------------------------------------------------------------------------
@@ -2275,21 +2759,21 @@ public:
                                             const std::vector<double>& coefficients, double a, double b) const {
         CheckCiphertext(ciphertext);
 
-        return GetScheme()->EvalChebyshevSeries(ciphertext, coefficients, a, b);
+        return GetScheme()->EvalChebyshevSeries(RelinearizeLazy(ciphertext), coefficients, a, b);
     }
 
     Ciphertext<Element> EvalChebyshevSeriesLinear(ConstCiphertext<Element> ciphertext,
                                                   const std::vector<double>& coefficients, double a, double b) const {
         CheckCiphertext(ciphertext);
 
-        return GetScheme()->EvalChebyshevSeriesLinear(ciphertext, coefficients, a, b);
+        return GetScheme()->EvalChebyshevSeriesLinear(RelinearizeLazy(ciphertext), coefficients, a, b);
     }
 
     Ciphertext<Element> EvalChebyshevSeriesPS(ConstCiphertext<Element> ciphertext,
                                               const std::vector<double>& coefficients, double a, double b) const {
         CheckCiphertext(ciphertext);
 
-        return GetScheme()->EvalChebyshevSeriesPS(ciphertext, coefficients, a, b);
+        return GetScheme()->EvalChebyshevSeriesPS(RelinearizeLazy(ciphertext), coefficients, a, b);
     }
 
     //------------------------------------------------------------------------------
@@ -2467,7 +2951,7 @@ public:
         CheckCiphertext(ciphertext);
         CheckKey(evalKey);
 
-        return GetScheme()->ReEncrypt(ciphertext, evalKey, publicKey);
+        return GetScheme()->ReEncrypt(RelinearizeLazy(ciphertext), evalKey, publicKey);
     }
 
     //------------------------------------------------------------------------------
@@ -2522,7 +3006,8 @@ public:
 
         for (size_t i = 0; i < ciphertextVec.size(); i++) {
             CheckCiphertext(ciphertextVec[i]);
-            newCiphertextVec.push_back(GetScheme()->MultipartyDecryptLead(ciphertextVec[i], privateKey));
+            newCiphertextVec.push_back(
+                GetScheme()->MultipartyDecryptLead(RelinearizeLazy(ciphertextVec[i]), privateKey));
         }
 
         return newCiphertextVec;
@@ -2542,7 +3027,8 @@ public:
         std::vector<Ciphertext<Element>> newCiphertextVec;
         for (size_t i = 0; i < ciphertextVec.size(); i++) {
             CheckCiphertext(ciphertextVec[i]);
-            newCiphertextVec.push_back(GetScheme()->MultipartyDecryptMain(ciphertextVec[i], privateKey));
+            newCiphertextVec.push_back(
+                GetScheme()->MultipartyDecryptMain(RelinearizeLazy(ciphertextVec[i]), privateKey));
         }
 
         return newCiphertextVec;
@@ -2783,9 +3269,34 @@ public:
    * for encoding and decoding
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to rescale message by to improve precision. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64.
+   * @param precompute - if true (default), the plaintexts of the linear maps are encoded here and kept for the
+   * lifetime of the context; if false, only the parameters needed to re-encode them are stored and the plaintexts
+   * are encoded on demand in EvalBootstrap (see SetBootstrapCacheBudget)
    */
     void EvalBootstrapSetup(std::vector<uint32_t> levelBudget = {5, 4}, std::vector<uint32_t> dim1 = {0, 0},
-                            uint32_t slots = 0, uint32_t correctionFactor = 0);
+                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true);
+
+    /**
+   * Sets the memory budget for the plaintexts of bootstrapping linear maps that are encoded on demand
+   * (EvalBootstrapSetup with precompute = false). The least recently used linear maps are evicted once the
+   * budget is exceeded; a budget of 0 (default) disables caching so the plaintexts are encoded on every use.
+   *
+   * @param bytes cache budget in bytes.
+   */
+    void SetBootstrapCacheBudget(size_t bytes) {
+        GetScheme()->SetBootstrapCacheBudget(bytes);
+    }
+
+    /**
+   * Sets the memory budget for CKKS plaintexts re-encoded by EvalMult and EvalAdd. A plaintext encoded at a
+   * different level or depth than the ciphertext it is used with is otherwise adjusted (towers dropped, scaled,
+   * rescaled) on every call; with a budget, it is re-encoded once at the target level and depth and kept,
+   * keyed by its values, level, depth and number of slots. The least recently used plaintexts are evicted
+   * once the budget is exceeded; a budget of 0 (default) disables the cache and drops its contents.
+   *
+   * @param bytes cache budget in bytes.
+   */
+    void SetPlaintextCacheBudget(size_t bytes);
 
     /**
    * Generates all automorphism keys for EvalBT.
@@ -2809,6 +3320,34 @@ public:
     Ciphertext<Element> EvalBootstrap(ConstCiphertext<Element> ciphertext, uint32_t numIterations = 1,
                                       uint32_t precision = 0) const;
 
+    /**
+   * Serializes the bootstrapping precomputation generated by EvalBootstrapSetup for the given
+   * number of slots, so other processes can load it instead of running EvalBootstrapSetup.
+   * The serialization records the ring dimension and RNS moduli of this context; the level
+   * budget and inner dimensions are part of the precomputation itself.
+   * Include "scheme/ckksrns/ckksrns-ser.h" and "cryptocontext-ser.h" to use it.
+   *
+   * @param ser - stream to serialize to
+   * @param sertype - type of serialization
+   * @param slots - number of slots (0 means fully packed)
+   * @return true on success
+   */
+    template <typename ST>
+    bool SerializeBootstrapPrecom(std::ostream& ser, const ST& sertype, uint32_t slots = 0) const;
+
+    /**
+   * Loads a bootstrapping precomputation written by SerializeBootstrapPrecom into this context,
+   * replacing any precomputation for the same number of slots. This takes the place of
+   * EvalBootstrapSetup; the rotation keys still have to be generated or deserialized.
+   * Throws if the precomputation was generated for a different ring dimension or modulus chain.
+   *
+   * @param ser - stream with a serialization
+   * @param sertype - type of serialization
+   * @return true on success
+   */
+    template <typename ST>
+    bool DeserializeBootstrapPrecom(std::istream& ser, const ST& sertype);
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(cereal::make_nvp("cc", params));
@@ -37,7 +37,9 @@
 #include "scheme/scheme-id.h"
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace lbcrypto {
@@ -50,20 +52,41 @@ class CryptoParametersBase;
 /**
  * @brief CryptoContextFactory
  *
- * A class that contains all generated contexts and static methods to access/release them
+ * A class that contains all generated contexts and static methods to access/release them.
+ * Contexts are indexed by a hash of their parameters, so looking up the context of a
+ * deserialized object does not depend on the number of registered contexts. Lookups take
+ * a shared lock and may run concurrently; only registering or releasing a context takes
+ * an exclusive lock.
  */
 template <typename Element>
 class CryptoContextFactory {
     static std::vector<CryptoContext<Element>> AllContexts;
+    // AllContexts indexed by ParameterHash(); both are guarded by ContextsMutex
+    static std::unordered_multimap<size_t, CryptoContext<Element>> ContextIndex;
+    static std::shared_mutex ContextsMutex;
 
 protected:
     static CryptoContext<Element> FindContext(std::shared_ptr<CryptoParametersBase<Element>> params,
         std::shared_ptr<SchemeBase<Element>> scheme);
     static void AddContext(CryptoContext<Element>);
 
+    /**
+     * Hash of the element parameters compared by CryptoParametersBase::operator==: equal
+     * parameters always have equal hashes, collisions are resolved by a full comparison
+     */
+    static size_t ParameterHash(const CryptoParametersBase<Element>& params);
+
 public:
     static void ReleaseAllContexts();
 
+    /**
+     * Removes a single context from the registry, e.g. when the tenant using it is gone.
+     * Objects that still hold the context keep it alive, but GetContext no longer returns it.
+     * @param cc the context to release
+     * @return true if the context was registered
+     */
+    static bool ReleaseContext(const CryptoContext<Element>& cc);
+
     static int GetContextCount();
 
     static CryptoContext<Element> GetContext(std::shared_ptr<CryptoParametersBase<Element>> params,
@@ -75,6 +98,7 @@ public:
     // allows to avoid circular dependencies in some places by including cryptocontext-fwd.h
     static CryptoContext<Element> GetFullContextByDeserializedContext(const CryptoContext<Element> context);
 
+    // the returned reference must not be used while other threads register or release contexts
     static const std::vector<CryptoContext<Element>>& GetAllContexts();
 };
 }  // namespace lbcrypto
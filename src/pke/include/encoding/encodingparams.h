@@ -46,6 +46,7 @@
 
 namespace lbcrypto {
 class EncodingParamsImpl;
+struct PackedEncodingTables;
 
 typedef std::shared_ptr<EncodingParamsImpl> EncodingParams;
 
@@ -89,6 +90,7 @@ public:
         m_plaintextBigRootOfUnity = rhs.m_plaintextBigRootOfUnity;
         m_plaintextGenerator      = rhs.m_plaintextGenerator;
         m_batchSize               = rhs.m_batchSize;
+        SetPackedEncodingTables(rhs.GetPackedEncodingTables());
     }
 
     /**
@@ -103,6 +105,7 @@ public:
         m_plaintextBigRootOfUnity = std::move(rhs.m_plaintextBigRootOfUnity);
         m_plaintextGenerator      = std::move(rhs.m_plaintextGenerator);
         m_batchSize               = rhs.m_batchSize;
+        SetPackedEncodingTables(rhs.GetPackedEncodingTables());
     }
 
     /**
@@ -118,6 +121,7 @@ public:
         m_plaintextBigRootOfUnity = rhs.m_plaintextBigRootOfUnity;
         m_plaintextGenerator      = rhs.m_plaintextGenerator;
         m_batchSize               = rhs.m_batchSize;
+        SetPackedEncodingTables(rhs.GetPackedEncodingTables());
         return *this;
     }
 
@@ -143,6 +147,7 @@ public:
    */
     void SetPlaintextModulus(PlaintextModulus plaintextModulus) {
         m_plaintextModulus = plaintextModulus;
+        SetPackedEncodingTables(nullptr);
     }
 
     /**
@@ -158,6 +163,7 @@ public:
    */
     void SetPlaintextRootOfUnity(const NativeInteger& plaintextRootOfUnity) {
         m_plaintextRootOfUnity = plaintextRootOfUnity;
+        SetPackedEncodingTables(nullptr);
     }
 
     /**
@@ -173,6 +179,7 @@ public:
    */
     void SetPlaintextBigModulus(const NativeInteger& plaintextBigModulus) {
         m_plaintextBigModulus = plaintextBigModulus;
+        SetPackedEncodingTables(nullptr);
     }
 
     /**
@@ -188,6 +195,7 @@ public:
    */
     void SetPlaintextBigRootOfUnity(const NativeInteger& plaintextBigRootOfUnity) {
         m_plaintextBigRootOfUnity = plaintextBigRootOfUnity;
+        SetPackedEncodingTables(nullptr);
     }
 
     /**
@@ -203,6 +211,7 @@ public:
    */
     void SetPlaintextGenerator(usint& plaintextGenerator) {
         m_plaintextGenerator = plaintextGenerator;
+        SetPackedEncodingTables(nullptr);
     }
 
     /**
@@ -213,6 +222,23 @@ public:
         return m_batchSize;
     }
 
+    /**
+   * @brief Getter for the tables used by packed encoding. The tables are immutable,
+   * so they can be used by many threads at once without locking.
+   * @return The tables, or nullptr if they have not been computed for these parameters.
+   */
+    std::shared_ptr<const PackedEncodingTables> GetPackedEncodingTables() const {
+        return std::atomic_load(&m_packedEncodingTables);
+    }
+
+    /**
+   * @brief Setter for the tables used by packed encoding. Changing any of the
+   * plaintext parameters above discards them.
+   */
+    void SetPackedEncodingTables(std::shared_ptr<const PackedEncodingTables> tables) {
+        std::atomic_store(&m_packedEncodingTables, std::move(tables));
+    }
+
     /**
    * @brief Setter for the batch size
    */
@@ -274,6 +300,8 @@ private:
     uint32_t m_plaintextGenerator;
     // maximum batch size used by EvalSumKeyGen for packed encoding
     uint32_t m_batchSize;
+    // permutations and roots of unity derived by PackedEncoding::SetParams; not serialized
+    std::shared_ptr<const PackedEncodingTables> m_packedEncodingTables;
 
 public:
     template <class Archive>
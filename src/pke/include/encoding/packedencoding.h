@@ -53,6 +53,28 @@ namespace lbcrypto {
 // STL pair used as a key for some tables in PackedEncoding
 using ModulusM = std::pair<NativeInteger, uint64_t>;
 
+/**
+ * @brief Precomputed tables used by PackedEncoding for one plaintext modulus and
+ * cyclotomic order. They are built once by PackedEncoding::SetParams, attached to
+ * the EncodingParams and never modified afterwards, so encoding threads share them
+ * without locking.
+ */
+struct PackedEncodingTables {
+    // cyclotomic order and plaintext modulus the tables were built for
+    usint m = 0;
+    NativeInteger modulus;
+    // initial root of unity for plaintext space
+    NativeInteger initRoot;
+    // modulus and root of unity to be used for Arbitrary CRT
+    NativeInteger bigModulus;
+    NativeInteger bigRoot;
+    // generator of the automorphism group (arbitrary cyclotomics only)
+    usint automorphismGenerator = 0;
+    // permutations that interchange the automorphism and CRT orderings
+    std::vector<usint> toCRTPerm;
+    std::vector<usint> fromCRTPerm;
+};
+
 /**
  * @class PackedEncoding
  * @brief Type used for representing IntArray types.
@@ -107,9 +129,7 @@ public:
    */
     PackedEncoding() : PlaintextImpl(std::shared_ptr<Poly::Params>(0), nullptr), value() {}
 
-    static usint GetAutomorphismGenerator(usint m) {
-        return m_automorphismGenerator[m];
-    }
+    static usint GetAutomorphismGenerator(usint m);
 
     bool Encode();
 
@@ -151,6 +171,15 @@ public:
    */
     static void SetParams(usint m, EncodingParams params);
 
+    /**
+   * @brief Checks whether the encoding tables for the given parameters have
+   * been set, so that SetParams can be skipped
+   * @param m the encoding cyclotomic order.
+   * @params params data structure storing encoding parameters
+   * @return true if params carries the tables for m
+   */
+    static bool HasParams(usint m, EncodingParams params);
+
     /**
    * @brief Method to set encoding params (this method should eventually be
    * replaced by void SetParams(usint m, EncodingParams params);)
@@ -200,20 +229,22 @@ public:
     }
 
 private:
-    // initial root of unity for plaintext space
-    static std::map<ModulusM, NativeInteger> m_initRoot;
-    // modulus and root of unity to be used for Arbitrary CRT
-    static std::map<ModulusM, NativeInteger> m_bigModulus;
-    static std::map<ModulusM, NativeInteger> m_bigRoot;
-
-    // stores the list of primitive roots used in packing.
+    // stores the list of primitive roots used in packing; only read by GetAutomorphismGenerator
     static std::map<usint, usint> m_automorphismGenerator;
-    static std::map<usint, std::vector<usint>> m_toCRTPerm;
-    static std::map<usint, std::vector<usint>> m_fromCRTPerm;
 
-    static void SetParams_2n(usint m, const NativeInteger& modulusNI);
+    /**
+   * @brief Computes the tables for the given cyclotomic order, using the roots and
+   * generator already present in params and deriving the missing ones
+   */
+    static std::shared_ptr<const PackedEncodingTables> MakeTables(usint m, const EncodingParamsImpl& params);
+
+    static void MakeTables_2n(PackedEncodingTables& tables);
 
-    static void SetParams_2n(usint m, EncodingParams params);
+    /**
+   * @brief Returns the tables attached to params, computing and attaching them if
+   * params has none for m (e.g. parameters that did not come from a crypto context)
+   */
+    static std::shared_ptr<const PackedEncodingTables> GetTables(usint m, const EncodingParams& params);
 
     /**
    * @brief Packs the slot values into aggregate plaintext space.
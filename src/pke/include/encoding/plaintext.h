@@ -188,6 +188,16 @@ public:
         return isEncoded;
     }
 
+    /**
+   * GetMemoryUsage
+   * @return number of bytes held by the plaintext object and its encoded polynomials
+   */
+    size_t GetMemoryUsage() const {
+        return sizeof(*this) + (encodedVector.GetMemoryUsage() - sizeof(encodedVector)) +
+               (encodedNativeVector.GetMemoryUsage() - sizeof(encodedNativeVector)) +
+               (encodedVectorDCRT.GetMemoryUsage() - sizeof(encodedVectorDCRT));
+    }
+
     /**
    * GetEncodingParams
    * @return Encoding params used with this plaintext
@@ -228,6 +228,16 @@ public:
         OPENFHE_THROW(not_implemented_error, "ClearKeys operation is not supported");
     }
 
+    /**
+   * Returns the number of bytes held by the key polynomials.
+   * To be overridden by derived class.
+   *
+   * @return memory usage in bytes
+   */
+    virtual size_t GetMemoryUsage() const {
+        return sizeof(*this);
+    }
+
     friend bool operator==(const EvalKeyImpl& a, const EvalKeyImpl& b) {
         return a.key_compare(b);
     }
@@ -34,10 +34,13 @@
 
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
+#include "math/distributiongenerator.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
+#include <tuple>
 #include <utility>
 
 /**
@@ -68,7 +71,8 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
-        m_rKey = rhs.m_rKey;
+        m_rKey  = rhs.m_rKey;
+        m_aSeed = rhs.m_aSeed;
     }
 
     /**
@@ -77,7 +81,8 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
-        m_rKey = std::move(rhs.m_rKey);
+        m_rKey  = std::move(rhs.m_rKey);
+        m_aSeed = std::move(rhs.m_aSeed);
     }
 
     operator bool() const {
@@ -92,6 +97,7 @@ public:
     const EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        this->m_aSeed = rhs.m_aSeed;
         return *this;
     }
 
@@ -104,6 +110,7 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_aSeed       = std::move(rhs.m_aSeed);
         return *this;
     }
 
@@ -115,6 +122,7 @@ public:
    */
     virtual void SetAVector(const std::vector<Element>& a) {
         m_rKey.insert(m_rKey.begin() + 0, a);
+        m_aSeed.clear();
     }
 
     /**
@@ -125,6 +133,7 @@ public:
    */
     virtual void SetAVector(std::vector<Element>&& a) {
         m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        m_aSeed.clear();
     }
 
     /**
@@ -137,6 +146,51 @@ public:
         return m_rKey.at(0);
     }
 
+    /**
+   * Records the seed Element Vector A was expanded from with ExpandAVector.
+   * Keys with a seed are serialized without Vector A, which is expanded again
+   * when the key is loaded. SetAVector clears the seed.
+   *
+   * @param &seed the seed.
+   */
+    void SetASeed(const PRNGSeed& seed) {
+        m_aSeed.assign(seed.begin(), seed.end());
+    }
+
+    /**
+   * @return true if Element Vector A was expanded from a seed
+   */
+    bool HasASeed() const {
+        return !m_aSeed.empty();
+    }
+
+    /**
+   * Getter function to access the seed of Element Vector A.
+   *
+   * @return the seed; only valid if HasASeed()
+   */
+    PRNGSeed GetASeed() const {
+        PRNGSeed seed{};
+        std::copy(m_aSeed.begin(), m_aSeed.end(), seed.begin());
+        return seed;
+    }
+
+    /**
+   * Expands one uniformly random element of Vector A from a seed. Element i
+   * uses the seed with its second to last word replaced by i.
+   *
+   * @param &seed the seed.
+   * @param i index of the element in Vector A.
+   * @param params parameters of the element.
+   * @return the element, in EVALUATION format.
+   */
+    static Element ExpandAVector(const PRNGSeed& seed, size_t i,
+                                 const std::shared_ptr<typename Element::Params> params) {
+        PRNGSeed elementSeed                = seed;
+        elementSeed[elementSeed.size() - 2] = static_cast<PRNG::result_type>(i);
+        return Element(elementSeed, params, Format::EVALUATION);
+    }
+
     /**
    * Setter function to store Relinearization Element Vector B.
    * Overrides base class implementation.
@@ -234,6 +288,18 @@ public:
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_aSeed.clear();
+    }
+
+    size_t GetMemoryUsage() const override {
+        size_t bytes = sizeof(*this);
+        for (const auto& keys : m_rKey) {
+            for (const auto& key : keys)
+                bytes += key.GetMemoryUsage();
+        }
+        for (const auto& key : m_dcrtKeys)
+            bytes += key.GetMemoryUsage();
+        return bytes;
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -258,7 +324,12 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        ar(::cereal::make_nvp("s", m_aSeed));
+        // Vector A is replaced by its seed
+        if (m_aSeed.empty())
+            ar(::cereal::make_nvp("k", m_rKey));
+        else
+            ar(::cereal::make_nvp("b", m_rKey.at(1)));
     }
 
     template <class Archive>
@@ -268,19 +339,45 @@ public:
                                                  " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        m_aSeed.clear();
+        if (version > 1)
+            ar(::cereal::make_nvp("s", m_aSeed));
+        if (m_aSeed.empty()) {
+            ar(::cereal::make_nvp("k", m_rKey));
+            return;
+        }
+        if (m_aSeed.size() != std::tuple_size<PRNGSeed>::value)
+            OPENFHE_THROW(deserialize_error, "the seed of vector A has " + std::to_string(m_aSeed.size()) +
+                                                 " words instead of " +
+                                                 std::to_string(std::tuple_size<PRNGSeed>::value));
+
+        std::vector<Element> b;
+        ar(::cereal::make_nvp("b", b));
+
+        const PRNGSeed seed = GetASeed();
+        std::vector<Element> a;
+        a.reserve(b.size());
+        for (size_t i = 0; i < b.size(); i++)
+            a.push_back(ExpandAVector(seed, i, b[i].GetParams()));
+
+        m_rKey.clear();
+        m_rKey.push_back(std::move(a));
+        m_rKey.push_back(std::move(b));
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
     // private member to store vector of vector of Element.
     std::vector<std::vector<Element>> m_rKey;
 
+    // seed Vector A was expanded from (a PRNGSeed); empty if A is stored as is
+    std::vector<uint32_t> m_aSeed;
+
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
 };
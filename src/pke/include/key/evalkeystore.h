@@ -0,0 +1,115 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Sources automorphism keys are loaded from on first use (see CryptoContextImpl::SetEvalKeyStore)
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "key/evalkey.h"
+#include "utils/serial.h"
+
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace lbcrypto {
+
+/**
+ * @brief Abstract interface for a store automorphism keys can be fetched from one by one
+ * @tparam Element a ring element.
+ */
+template <typename Element>
+class EvalKeyStore {
+public:
+    virtual ~EvalKeyStore() {}
+
+    /**
+   * Loads the automorphism key for a given automorphism index
+   *
+   * @param keyTag tag of the secret key the key was generated for
+   * @param index automorphism index
+   * @return the key or nullptr if the store does not hold it
+   */
+    virtual EvalKey<Element> LoadEvalAutomorphismKey(const std::string& keyTag, usint index) = 0;
+};
+
+/**
+ * @brief Key store backed by a directory with one serialized key per file
+ * @tparam Element a ring element.
+ * @tparam ST serialization type (SerType::SERBINARY or SerType::SERJSON)
+ */
+template <typename Element, typename ST>
+class EvalKeyDirectoryStore : public EvalKeyStore<Element> {
+public:
+    EvalKeyDirectoryStore(const std::string& directory, const ST& sertype)
+        : m_directory(directory), m_sertype(sertype) {}
+
+    /**
+   * Writes every key of an automorphism key map to its own file in a directory
+   *
+   * @param directory the directory; it has to exist
+   * @param evalKeyMap the keys, e.g. CryptoContextImpl::GetEvalAutomorphismKeyMap(keyTag)
+   * @param sertype serialization type
+   * @return true on success
+   */
+    static bool WriteEvalAutomorphismKeys(const std::string& directory,
+                                          const std::map<usint, EvalKey<Element>>& evalKeyMap, const ST& sertype) {
+        for (const auto& entry : evalKeyMap) {
+            if (!Serial::SerializeToFile(GetFileName(directory, entry.second->GetKeyTag(), entry.first), entry.second,
+                                         sertype))
+                return false;
+        }
+        return true;
+    }
+
+    EvalKey<Element> LoadEvalAutomorphismKey(const std::string& keyTag, usint index) override {
+        EvalKey<Element> key;
+        if (!Serial::DeserializeFromFile(GetFileName(m_directory, keyTag, index), key, m_sertype))
+            return nullptr;
+        return key;
+    }
+
+    static std::string GetFileName(const std::string& directory, const std::string& keyTag, usint index) {
+        return directory + "/" + keyTag + "_" + std::to_string(index) + ".key";
+    }
+
+private:
+    std::string m_directory;
+    ST m_sertype;
+};
+
+}  // namespace lbcrypto
+
+#endif
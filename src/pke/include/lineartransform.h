@@ -0,0 +1,212 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Precomputations for plaintext matrix - encrypted vector products evaluated with the
+  baby-step giant-step diagonal method, and for encrypted matrix - encrypted matrix products
+ */
+
+#ifndef LBCRYPTO_CRYPTO_LINEARTRANSFORM_H
+#define LBCRYPTO_CRYPTO_LINEARTRANSFORM_H
+
+#include "encoding/plaintext-fwd.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief LinearTransformPrecom
+ *
+ * Holds a dim x dim plaintext matrix in diagonal form together with its baby-step
+ * giant-step decomposition. Diagonal k stores the entries A[i][(i + k) mod dim].
+ * Zero diagonals are not stored, so sparse (banded, permutation) matrices only pay
+ * for the rotations they need.
+ *
+ * The diagonals are encoded lazily the first time the transform is applied at a
+ * given level, and the encodings are cached for subsequent calls.
+ */
+class LinearTransformPrecom {
+public:
+    /**
+   * @param dim dimension of the (padded) matrix; a power of two not larger than slots
+   * @param slots number of slots of the ciphertexts the transform is applied to
+   * @param diagonals map from diagonal index in [0, dim) to its dim entries
+   * @param bStep baby-step dimension; 0 selects the one minimizing the number of rotations
+   */
+    LinearTransformPrecom(uint32_t dim, uint32_t slots, std::map<uint32_t, std::vector<double>> diagonals,
+                          uint32_t bStep = 0);
+
+    /**
+   * Builds the diagonal form of a dense rows x cols matrix, zero-padded to the
+   * smallest power of two dim >= max(rows, cols).
+   */
+    static std::shared_ptr<LinearTransformPrecom> FromMatrix(const std::vector<std::vector<double>>& A,
+                                                             uint32_t slots, uint32_t bStep = 0);
+
+    uint32_t GetDimension() const {
+        return m_dim;
+    }
+
+    uint32_t GetSlots() const {
+        return m_slots;
+    }
+
+    uint32_t GetBabyStep() const {
+        return m_bStep;
+    }
+
+    /**
+   * Indices of the nonzero diagonals, in increasing order
+   */
+    const std::vector<uint32_t>& GetDiagonalIndices() const {
+        return m_indices;
+    }
+
+    /**
+   * The diagonal at position pos of GetDiagonalIndices(), laid out over all slots
+   * and pre-rotated by the giant step it belongs to
+   */
+    std::vector<double> GetSlotVector(uint32_t pos) const;
+
+    /**
+   * Distinct baby-step rotations (including 0) needed by the nonzero diagonals
+   */
+    const std::vector<int32_t>& GetBabySteps() const {
+        return m_babySteps;
+    }
+
+    /**
+   * Distinct giant-step rotations (including 0) needed by the nonzero diagonals
+   */
+    const std::vector<int32_t>& GetGiantSteps() const {
+        return m_giantSteps;
+    }
+
+    /**
+   * Rotations used to replicate a zero-padded input vector of length dim over all slots
+   */
+    std::vector<int32_t> GetReplicationSteps() const;
+
+    /**
+   * All rotation indices for which automorphism keys have to be generated
+   */
+    std::vector<int32_t> GetRotationIndices() const;
+
+    /**
+   * Returns the encoded diagonals cached for the given level, or an empty vector
+   */
+    std::vector<ConstPlaintext> GetEncodedDiagonals(uint32_t level) const;
+
+    void SetEncodedDiagonals(uint32_t level, std::vector<ConstPlaintext> encoded) const;
+
+    /**
+   * Drops all cached encodings
+   */
+    void ClearCache() const;
+
+private:
+    uint32_t m_dim;
+    uint32_t m_slots;
+    uint32_t m_bStep;
+    std::vector<uint32_t> m_indices;
+    std::vector<std::vector<double>> m_diagonals;
+    std::vector<int32_t> m_babySteps;
+    std::vector<int32_t> m_giantSteps;
+
+    mutable std::mutex m_cacheMutex;
+    mutable std::map<uint32_t, std::vector<ConstPlaintext>> m_encoded;
+};
+
+/**
+ * @brief MatMulPrecom
+ *
+ * Precomputed permutations for the product of two encrypted d x d matrices packed
+ * row by row into the first d * d slots (Jiang, Kim, Lauter and Song, "Secure
+ * Outsourced Matrix Computation and Application to Neural Networks",
+ * https://eprint.iacr.org/2018/1041). The product consumes three levels.
+ */
+class MatMulPrecom {
+public:
+    MatMulPrecom(uint32_t d, uint32_t slots);
+
+    uint32_t GetDimension() const {
+        return m_d;
+    }
+
+    /**
+   * The permutation A[i][j] -> A[i][i + j]
+   */
+    const std::shared_ptr<LinearTransformPrecom>& GetSigma() const {
+        return m_sigma;
+    }
+
+    /**
+   * The permutation B[i][j] -> B[i + j][j]
+   */
+    const std::shared_ptr<LinearTransformPrecom>& GetTau() const {
+        return m_tau;
+    }
+
+    /**
+   * Column shift A[i][j] -> A[i][j + k] for 1 <= k < d
+   */
+    const std::shared_ptr<LinearTransformPrecom>& GetColumnShift(uint32_t k) const {
+        return m_phi[k - 1];
+    }
+
+    /**
+   * Row shift B[i][j] -> B[i + k][j] for 1 <= k < d
+   */
+    const std::shared_ptr<LinearTransformPrecom>& GetRowShift(uint32_t k) const {
+        return m_psi[k - 1];
+    }
+
+    /**
+   * All rotation indices for which automorphism keys have to be generated
+   */
+    std::vector<int32_t> GetRotationIndices() const;
+
+private:
+    uint32_t m_d;
+    std::shared_ptr<LinearTransformPrecom> m_sigma;
+    std::shared_ptr<LinearTransformPrecom> m_tau;
+    std::vector<std::shared_ptr<LinearTransformPrecom>> m_phi;
+    std::vector<std::shared_ptr<LinearTransformPrecom>> m_psi;
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_CRYPTO_LINEARTRANSFORM_H
@@ -123,6 +123,17 @@ public:
     std::string SerializedObjectName() const {
         return "PKEBFVRNS";
     }
+
+private:
+    /**
+   * Extends a plaintext in COEFFICIENT format to the towers of params (the basis Qr of EXTENDED encryption)
+   *
+   * @param ptxt the plaintext over Q
+   * @param params the parameters of the extended basis
+   * @param t the plaintext modulus
+   * @return the plaintext over the extended basis
+   */
+    DCRTPoly ExtendPlaintext(const DCRTPoly& ptxt, const std::shared_ptr<ParmType> params, PlaintextModulus t) const;
 };
 }  // namespace lbcrypto
 
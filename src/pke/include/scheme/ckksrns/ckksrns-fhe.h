@@ -33,12 +33,15 @@
 #define LBCRYPTO_CRYPTO_CKKSRNS_FHE_H
 
 #include "constants.h"
+#include "encoding/ckkspackedencoding.h"
 #include "encoding/plaintext-fwd.h"
 #include "schemerns/rns-fhe.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 #include "utils/caller_info.h"
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <map>
@@ -57,6 +60,11 @@ public:
     CKKSBootstrapPrecom(const CKKSBootstrapPrecom& rhs) {
         m_dim1         = rhs.m_dim1;
         m_slots        = rhs.m_slots;
+        m_precompute   = rhs.m_precompute;
+        m_scaleEnc     = rhs.m_scaleEnc;
+        m_scaleDec     = rhs.m_scaleDec;
+        m_levelEnc     = rhs.m_levelEnc;
+        m_levelDec     = rhs.m_levelDec;
         m_paramsEnc    = rhs.m_paramsEnc;
         m_paramsDec    = rhs.m_paramsDec;
         m_U0Pre        = rhs.m_U0Pre;
@@ -68,6 +76,11 @@ public:
     CKKSBootstrapPrecom(CKKSBootstrapPrecom&& rhs) {
         m_dim1         = rhs.m_dim1;
         m_slots        = rhs.m_slots;
+        m_precompute   = rhs.m_precompute;
+        m_scaleEnc     = rhs.m_scaleEnc;
+        m_scaleDec     = rhs.m_scaleDec;
+        m_levelEnc     = rhs.m_levelEnc;
+        m_levelDec     = rhs.m_levelDec;
         m_paramsEnc    = std::move(rhs.m_paramsEnc);
         m_paramsDec    = std::move(rhs.m_paramsDec);
         m_U0Pre        = std::move(rhs.m_U0Pre);
@@ -77,12 +90,77 @@ public:
     }
 
     virtual ~CKKSBootstrapPrecom() {}
+
+    // number of bytes held by the precomputation, dominated by the encoded plaintexts
+    size_t GetMemoryUsage() const;
+
+    template <class Archive>
+    void save(Archive& ar, std::uint32_t const version) const {
+        ar(cereal::make_nvp("d1", m_dim1));
+        ar(cereal::make_nvp("s", m_slots));
+        ar(cereal::make_nvp("pc", m_precompute));
+        ar(cereal::make_nvp("se", m_scaleEnc));
+        ar(cereal::make_nvp("sd", m_scaleDec));
+        ar(cereal::make_nvp("le", m_levelEnc));
+        ar(cereal::make_nvp("ld", m_levelDec));
+        ar(cereal::make_nvp("pe", m_paramsEnc));
+        ar(cereal::make_nvp("pd", m_paramsDec));
+        ar(cereal::make_nvp("u0", ToSerial(m_U0Pre)));
+        ar(cereal::make_nvp("u0t", ToSerial(m_U0hatTPre)));
+        ar(cereal::make_nvp("u0f", ToSerial(m_U0PreFFT)));
+        ar(cereal::make_nvp("u0tf", ToSerial(m_U0hatTPreFFT)));
+    }
+
+    template <class Archive>
+    void load(Archive& ar, std::uint32_t const version) {
+        if (version > SerializedVersion()) {
+            OPENFHE_THROW(deserialize_error, "serialized object version " + std::to_string(version) +
+                                                 " is from a later version of the library");
+        }
+        ar(cereal::make_nvp("d1", m_dim1));
+        ar(cereal::make_nvp("s", m_slots));
+        ar(cereal::make_nvp("pc", m_precompute));
+        ar(cereal::make_nvp("se", m_scaleEnc));
+        ar(cereal::make_nvp("sd", m_scaleDec));
+        ar(cereal::make_nvp("le", m_levelEnc));
+        ar(cereal::make_nvp("ld", m_levelDec));
+        ar(cereal::make_nvp("pe", m_paramsEnc));
+        ar(cereal::make_nvp("pd", m_paramsDec));
+
+        std::vector<SerialPlaintext> linear;
+        std::vector<std::vector<SerialPlaintext>> fft;
+        ar(cereal::make_nvp("u0", linear));
+        m_U0Pre = FromSerial(linear);
+        ar(cereal::make_nvp("u0t", linear));
+        m_U0hatTPre = FromSerial(linear);
+        ar(cereal::make_nvp("u0f", fft));
+        m_U0PreFFT = FromSerial(fft);
+        ar(cereal::make_nvp("u0tf", fft));
+        m_U0hatTPreFFT = FromSerial(fft);
+    }
+
+    std::string SerializedObjectName() const {
+        return "CKKSBootstrapPrecom";
+    }
+    static uint32_t SerializedVersion() {
+        return 1;
+    }
     // the inner dimension in the baby-step giant-step strategy
     uint32_t m_dim1 = 0;
 
     // number of slots for which the bootstrapping is performed
     uint32_t m_slots = 0;
 
+    // whether the plaintexts of the linear maps below were encoded in EvalBootstrapSetup;
+    // if not, they are re-encoded on demand from the scaling factors and levels that follow
+    bool m_precompute = true;
+
+    // scaling factors and levels of the plaintexts for homomorphic encoding and decoding
+    double m_scaleEnc   = 1;
+    double m_scaleDec   = 1;
+    uint32_t m_levelEnc = 0;
+    uint32_t m_levelDec = 0;
+
     // level budget for homomorphic encoding, number of layers to collapse in one level,
     // number of layers remaining to be collapsed in one level to have exactly the number
     // of levels specified in the level budget, the number of rotations in one level,
@@ -110,6 +188,119 @@ public:
 
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ConstPlaintext>> m_U0hatTPreFFT;
+
+private:
+    // plaintexts are serialized as their encoded element and the metadata EvalBootstrap needs;
+    // the encoding parameters and the original slot values are not restored
+    struct SerialPlaintext {
+        ConstPlaintext pt;
+
+        template <class Archive>
+        void save(Archive& ar) const {
+            ar(cereal::make_nvp("v", pt != nullptr));
+            if (pt == nullptr)
+                return;
+            ar(cereal::make_nvp("e", pt->GetElement<DCRTPoly>()));
+            ar(cereal::make_nvp("d", static_cast<uint64_t>(pt->GetNoiseScaleDeg())));
+            ar(cereal::make_nvp("l", static_cast<uint64_t>(pt->GetLevel())));
+            ar(cereal::make_nvp("sf", pt->GetScalingFactor()));
+            ar(cereal::make_nvp("s", static_cast<uint32_t>(pt->GetSlots())));
+        }
+
+        template <class Archive>
+        void load(Archive& ar) {
+            bool valid = false;
+            ar(cereal::make_nvp("v", valid));
+            if (!valid) {
+                pt = nullptr;
+                return;
+            }
+            DCRTPoly element;
+            uint64_t noiseScaleDeg = 0;
+            uint64_t level         = 0;
+            double scalingFactor   = 0;
+            uint32_t slots         = 0;
+            ar(cereal::make_nvp("e", element));
+            ar(cereal::make_nvp("d", noiseScaleDeg));
+            ar(cereal::make_nvp("l", level));
+            ar(cereal::make_nvp("sf", scalingFactor));
+            ar(cereal::make_nvp("s", slots));
+
+            auto p = std::make_shared<CKKSPackedEncoding>(element.GetParams(), nullptr, std::vector<std::complex<double>>(),
+                                                          noiseScaleDeg, level, scalingFactor, slots);
+            p->GetElement<DCRTPoly>() = std::move(element);
+            pt = p;
+        }
+    };
+
+    static std::vector<SerialPlaintext> ToSerial(const std::vector<ConstPlaintext>& plaintexts) {
+        std::vector<SerialPlaintext> result(plaintexts.size());
+        for (size_t i = 0; i < plaintexts.size(); ++i)
+            result[i].pt = plaintexts[i];
+        return result;
+    }
+
+    static std::vector<std::vector<SerialPlaintext>> ToSerial(
+        const std::vector<std::vector<ConstPlaintext>>& plaintexts) {
+        std::vector<std::vector<SerialPlaintext>> result;
+        result.reserve(plaintexts.size());
+        for (const auto& level : plaintexts)
+            result.push_back(ToSerial(level));
+        return result;
+    }
+
+    static std::vector<ConstPlaintext> FromSerial(const std::vector<SerialPlaintext>& plaintexts) {
+        std::vector<ConstPlaintext> result(plaintexts.size());
+        for (size_t i = 0; i < plaintexts.size(); ++i)
+            result[i] = plaintexts[i].pt;
+        return result;
+    }
+
+    static std::vector<std::vector<ConstPlaintext>> FromSerial(
+        const std::vector<std::vector<SerialPlaintext>>& plaintexts) {
+        std::vector<std::vector<ConstPlaintext>> result;
+        result.reserve(plaintexts.size());
+        for (const auto& level : plaintexts)
+            result.push_back(FromSerial(level));
+        return result;
+    }
+};
+
+// A bootstrapping precomputation for one number of slots together with the data of the
+// crypto context it was generated for: the ring dimension, the RNS moduli and the correction
+// factor. This is the unit written by CryptoContextImpl::SerializeBootstrapPrecom.
+struct CKKSBootstrapArtifact {
+    uint32_t ringDim          = 0;
+    uint32_t correctionFactor = 0;
+    std::vector<NativeInteger> moduli;
+    std::shared_ptr<CKKSBootstrapPrecom> precom;
+
+    template <class Archive>
+    void save(Archive& ar, std::uint32_t const version) const {
+        ar(cereal::make_nvp("n", ringDim));
+        ar(cereal::make_nvp("q", moduli));
+        ar(cereal::make_nvp("cf", correctionFactor));
+        ar(cereal::make_nvp("bp", precom));
+    }
+
+    template <class Archive>
+    void load(Archive& ar, std::uint32_t const version) {
+        if (version > SerializedVersion()) {
+            OPENFHE_THROW(deserialize_error, "serialized object version " + std::to_string(version) +
+                                                 " is from a later version of the library");
+        }
+        ar(cereal::make_nvp("n", ringDim));
+        ar(cereal::make_nvp("q", moduli));
+        ar(cereal::make_nvp("cf", correctionFactor));
+        ar(cereal::make_nvp("bp", precom));
+    }
+
+    std::string SerializedObjectName() const {
+        return "CKKSBootstrapArtifact";
+    }
+    static uint32_t SerializedVersion() {
+        return 1;
+    }
 };
 
 class FHECKKSRNS : public FHERNS {
@@ -126,7 +317,22 @@ public:
     //------------------------------------------------------------------------------
 
     void EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
-                            std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor) override;
+                            std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
+                            bool precompute) override;
+
+    void SetBootstrapCacheBudget(size_t bytes) override;
+
+    /**
+   * Packs the bootstrapping precomputation for the given number of slots with the context data
+   * needed to validate it when it is loaded into another process
+   */
+    CKKSBootstrapArtifact GetBootstrapArtifact(const CryptoContextImpl<DCRTPoly>& cc, uint32_t slots) const;
+
+    /**
+   * Installs a deserialized bootstrapping precomputation in place of EvalBootstrapSetup;
+   * throws if it was generated for a different ring dimension or modulus chain
+   */
+    void SetBootstrapArtifact(const CryptoContextImpl<DCRTPoly>& cc, const CKKSBootstrapArtifact& artifact);
 
     std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalBootstrapKeyGen(const PrivateKey<DCRTPoly> privateKey,
                                                                             uint32_t slots) override;
@@ -134,6 +340,8 @@ public:
     Ciphertext<DCRTPoly> EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                        uint32_t precision) const override;
 
+    size_t GetMemoryUsage() const override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
@@ -214,6 +422,25 @@ private:
 
     void AdjustCiphertext(Ciphertext<DCRTPoly>& ciphertext, double correction) const;
 
+    // drops the plaintexts cached for the given number of slots
+    void ClearBootstrapCache(uint32_t slots);
+
+    /**
+   * Encodes the plaintexts of the linear map used for homomorphic encoding (CoeffsToSlots)
+   * or decoding (SlotsToCoeffs) from the parameters stored in precom. Only one of linear
+   * (linear method) and fft (FFT-like method) is filled in.
+   */
+    void EncodeBootstrapTransform(const CryptoContextImpl<DCRTPoly>& cc, const CKKSBootstrapPrecom& precom,
+                                  bool encoding, std::vector<ConstPlaintext>& linear,
+                                  std::vector<std::vector<ConstPlaintext>>& fft) const;
+
+    /**
+   * Applies the linear map for homomorphic encoding or decoding, using the precomputed
+   * plaintexts if available and the plaintext cache otherwise
+   */
+    Ciphertext<DCRTPoly> EvalBootstrapTransform(const CKKSBootstrapPrecom& precom, ConstCiphertext<DCRTPoly> ctxt,
+                                                bool encoding) const;
+
     void ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext) const;
 
     Plaintext MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, const std::shared_ptr<ParmType> params,
@@ -224,6 +451,13 @@ private:
 
     void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    /**
+   * Rotates ciphertext2, given in the extended basis P*Q, by index and adds the
+   * result to ciphertext1, also in P*Q (double hoisting of giant steps)
+   */
+    void EvalRotateAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                 int32_t index) const;
+
     Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
     EvalKey<DCRTPoly> ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const;
@@ -270,6 +504,19 @@ private:
         6;  // number of double-angle iterations in CKKS bootstrapping. Must be static because it is used in a static function.
     uint32_t m_correctionFactor = 0;  // correction factor, which we scale the message by to improve precision
 
+    // plaintexts of the linear maps encoded on demand, most recently used first
+    struct BootstrapCacheEntry {
+        uint32_t slots = 0;
+        bool encoding  = false;
+        size_t bytes   = 0;
+        std::shared_ptr<const std::vector<ConstPlaintext>> linear;
+        std::shared_ptr<const std::vector<std::vector<ConstPlaintext>>> fft;
+    };
+    mutable std::list<BootstrapCacheEntry> m_bootCache;
+    mutable std::mutex m_bootCacheMutex;
+    mutable size_t m_bootCacheBytes = 0;
+    size_t m_bootCacheBudget        = 0;
+
     // Chebyshev series coefficients for the SPARSE case
     const std::vector<double> g_coefficientsSparse{
         0, -0.0190665676962401,   0, -0.0181773905007824,   0, -0.0162862756167401,   0, -0.0131970301188482,
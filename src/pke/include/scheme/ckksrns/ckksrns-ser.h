@@ -42,4 +42,7 @@
 CEREAL_REGISTER_TYPE(lbcrypto::CryptoParametersCKKSRNS);
 CEREAL_REGISTER_TYPE(lbcrypto::SchemeCKKSRNS);
 
+CEREAL_CLASS_VERSION(lbcrypto::CKKSBootstrapPrecom, lbcrypto::CKKSBootstrapPrecom::SerializedVersion());
+CEREAL_CLASS_VERSION(lbcrypto::CKKSBootstrapArtifact, lbcrypto::CKKSBootstrapArtifact::SerializedVersion());
+
 #endif
@@ -75,9 +75,21 @@ public:
    * for encoding and decoding
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to rescale message by to improve precision. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64.
+   * @param precompute - if false, the linear maps are not encoded in advance but on demand in EvalBootstrap
    */
     virtual void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, std::vector<uint32_t> levelBudget,
-                                    std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor) {
+                                    std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
+                                    bool precompute) {
+        OPENFHE_THROW(not_implemented_error, "Not supported");
+    }
+
+    /**
+   * Sets the number of bytes that may be spent on caching the plaintexts of linear maps
+   * that were not precomputed in EvalBootstrapSetup
+   *
+   * @param bytes - cache budget in bytes; 0 disables caching
+   */
+    virtual void SetBootstrapCacheBudget(size_t bytes) {
         OPENFHE_THROW(not_implemented_error, "Not supported");
     }
 
@@ -113,6 +125,15 @@ public:
                                               uint32_t precision) const {
         OPENFHE_THROW(not_implemented_error, "EvalBootstrap is not implemented for this scheme");
     }
+
+    /**
+   * Returns the number of bytes held by the bootstrapping precomputations
+   *
+   * @return memory usage in bytes; 0 if the scheme keeps no precomputations
+   */
+    virtual size_t GetMemoryUsage() const {
+        return 0;
+    }
 };
 
 }  // namespace lbcrypto
@@ -838,6 +838,18 @@ protected:
 
     Ciphertext<Element> EvalSquareCore(ConstCiphertext<Element> ciphertext) const;
 
+    /**
+   * Tensor product of the elements of two ciphertexts, shared by the BFV, BGV and CKKS multiplications.
+   * The product of two 2-element ciphertexts takes 3 multiplications per coefficient (Karatsuba) and is
+   * computed in a single pass over each tower. The elements must be in EVALUATION format and have the
+   * same parameters.
+   *
+   * @param cv1 elements of the first ciphertext.
+   * @param cv2 elements of the second ciphertext.
+   * @return cv1.size() + cv2.size() - 1 elements of the product.
+   */
+    static std::vector<Element> TensorProduct(const std::vector<Element>& cv1, const std::vector<Element>& cv2);
+
     virtual Ciphertext<Element> EvalAddCore(ConstCiphertext<Element> ciphertext, const Element plaintext) const;
 
     void EvalAddCoreInPlace(Ciphertext<Element>& ciphertext, const Element plaintext) const;
@@ -1560,15 +1560,24 @@ public:
 
     void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, const std::vector<uint32_t>& levelBudget = {5, 4},
                             const std::vector<uint32_t>& dim1 = {0, 0}, uint32_t slots = 0,
-                            uint32_t correctionFactor = 0) {
+                            uint32_t correctionFactor = 0, bool precompute = true) {
         if (m_FHE) {
-            m_FHE->EvalBootstrapSetup(cc, levelBudget, dim1, slots, correctionFactor);
+            m_FHE->EvalBootstrapSetup(cc, levelBudget, dim1, slots, correctionFactor, precompute);
             return;
         }
 
         OPENFHE_THROW(config_error, "EvalBootstrapSetup operation has not been enabled");
     }
 
+    void SetBootstrapCacheBudget(size_t bytes) {
+        if (m_FHE) {
+            m_FHE->SetBootstrapCacheBudget(bytes);
+            return;
+        }
+
+        OPENFHE_THROW(config_error, "SetBootstrapCacheBudget operation has not been enabled");
+    }
+
     std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalBootstrapKeyGen(const PrivateKey<Element> privateKey,
                                                                            uint32_t slots) {
         if (m_FHE) {
@@ -1587,6 +1596,14 @@ public:
         OPENFHE_THROW(config_error, "EvalBootstrap operation has not been enabled");
     }
 
+    const std::shared_ptr<FHEBase<Element>>& GetFHE() const {
+        return m_FHE;
+    }
+
+    size_t GetFHEMemoryUsage() const {
+        return m_FHE ? m_FHE->GetMemoryUsage() : 0;
+    }
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("enabled", GetEnabled()));
@@ -398,6 +398,41 @@ public:
         return m_paramsComplPartQ[numTowers][digit];
     }
 
+    /**
+   * Method that returns the element parameters of the last (possibly
+   * incomplete) digit of a ciphertext with numTowers + 1 towers.
+   * Used in Hybrid key switching
+   *
+   * @param numTowers is the index of the last tower of the ciphertext.
+   * @return the partition.
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsPartQl(uint32_t numTowers) const {
+        return m_paramsPartQl[numTowers];
+    }
+
+    /**
+   * Method that returns the element parameters for {Q_l} = {q_0,...,q_l}.
+   * Used as the target basis of ModDown in Hybrid key switching
+   *
+   * @param l is the index of the last tower.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlKS(uint32_t l) const {
+        return m_paramsQlKS[l];
+    }
+
+    /**
+   * Method that returns the element parameters for the extended basis
+   * {Q_l, P} = {q_0,...,q_l,p_1,...,p_k}.
+   * Used in Hybrid key switching
+   *
+   * @param l is the index of the last tower of Q_l.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlP(uint32_t l) const {
+        return m_paramsQlP[l];
+    }
+
     /**
    * Method that returns the precomputed values for QHat^-1 mod qj within a
    * partition of towers, used in HYBRID.
@@ -1378,6 +1413,15 @@ protected:
     // Stores the parameters for complementary {\bar{Q_i},P}
     std::vector<std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>>> m_paramsComplPartQ;
 
+    // Stores the parameters for the last digit of a ciphertext at each level
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsPartQl;
+
+    // Stores the parameters for {Q_l} at each level
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlKS;
+
+    // Stores the parameters for the extended basis {Q_l,P} at each level
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlP;
+
     // Stores [{(Q_k)^(l)/q_i}^{-1}]_{q_i} for HYBRID
     std::vector<std::vector<std::vector<NativeInteger>>> m_PartQlHatInvModq;
 
@@ -113,6 +113,19 @@ public:
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
+    /**
+   * Secret-key encryption of zero whose uniform polynomial is expanded from a
+   * seed, so that the second element of the result can be restored from it
+   *
+   * @param privateKey private key used for encryption.
+   * @param params element parameters; nullptr selects those of the crypto parameters.
+   * @param &seed seed of the uniform polynomial.
+   * @return the two elements of the encryption of zero.
+   */
+    std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                           const std::shared_ptr<ParmType> params,
+                                                           const PRNGSeed& seed) const;
+
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PublicKey<DCRTPoly> publicKey,
                                                            const std::shared_ptr<ParmType> params,
                                                            const DggType& dgg) const override;
@@ -35,11 +35,18 @@
 
 #include "cryptocontext.h"
 
+#include "key/evalkeyrelin.h"
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "math/chebyshev.h"
 #include "schemerns/rns-scheme.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "scheme/ckksrns/ckksrns-fhe.h"
+
+#include <cmath>
+#include <limits>
+#include <set>
+#include <sstream>
 
 namespace lbcrypto {
 
@@ -314,6 +321,12 @@ CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys() {
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
     evalAutomorphismKeyMap().clear();
+
+    auto& ks = evalKeyStore();
+    std::lock_guard<std::mutex> lock(ks.mutex);
+    ks.lru.clear();
+    ks.loaded.clear();
+    ks.bytes = 0;
 }
 
 /**
@@ -325,6 +338,10 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id
     auto kd = evalAutomorphismKeyMap().find(id);
     if (kd != evalAutomorphismKeyMap().end())
         evalAutomorphismKeyMap().erase(kd);
+
+    auto& ks = evalKeyStore();
+    std::lock_guard<std::mutex> lock(ks.mutex);
+    ks.Forget(id);
 }
 
 /**
@@ -336,6 +353,11 @@ template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const CryptoContext<Element> cc) {
     for (auto it = evalAutomorphismKeyMap().begin(); it != evalAutomorphismKeyMap().end();) {
         if (it->second->begin()->second->GetCryptoContext() == cc) {
+            {
+                auto& ks = evalKeyStore();
+                std::lock_guard<std::mutex> lock(ks.mutex);
+                ks.Forget(it->first);
+            }
             it = evalAutomorphismKeyMap().erase(it);
         }
         else {
@@ -352,6 +374,136 @@ void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
     evalAutomorphismKeyMap()[onekey->second->GetKeyTag()] = mapToInsert;
 }
 
+template <typename Element>
+void CryptoContextImpl<Element>::SetEvalKeyStore(std::shared_ptr<EvalKeyStore<Element>> store, size_t budget) {
+    auto& ks = evalKeyStore();
+    std::lock_guard<std::mutex> lock(ks.mutex);
+    ks.store  = store;
+    ks.budget = budget;
+    ks.hasStore.store(store != nullptr);
+}
+
+template <typename Element>
+std::shared_ptr<EvalKeyStore<Element>> CryptoContextImpl<Element>::GetEvalKeyStore() {
+    auto& ks = evalKeyStore();
+    if (!ks.hasStore.load())
+        return nullptr;
+    std::lock_guard<std::mutex> lock(ks.mutex);
+    return ks.store;
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::LoadEvalAutomorphismKeys(const std::string& keyTag,
+                                                          const std::vector<usint>& indexList) {
+    auto& ks = evalKeyStore();
+    if (!ks.hasStore.load())
+        return;
+
+    // the keys that are not in memory are collected under the lock, read from the store without it
+    // and inserted under it again, so that concurrent operations do not wait for the store
+    std::shared_ptr<EvalKeyStore<Element>> store;
+    std::vector<usint> missing;
+    {
+        std::lock_guard<std::mutex> lock(ks.mutex);
+        if (ks.store == nullptr)
+            return;
+        store = ks.store;
+
+        auto& keyMaps = evalAutomorphismKeyMap();
+        auto ekv      = keyMaps.find(keyTag);
+        for (auto index : indexList) {
+            bool present = false;
+            if (ekv != keyMaps.end()) {
+                auto& keyMap = *ekv->second;
+                auto key     = keyMap.find(index);
+                auto lrf     = ks.loaded.find({keyTag, index});
+                if (lrf != ks.loaded.end()) {
+                    // the cache may have been replaced since the key was loaded
+                    if (key != keyMap.end() && key->second.get() == lrf->second->key) {
+                        ks.lru.splice(ks.lru.begin(), ks.lru, lrf->second);
+                        continue;
+                    }
+                    ks.Forget(lrf->second);
+                }
+                present = key != keyMap.end();
+            }
+            if (!present)
+                missing.push_back(index);
+        }
+    }
+
+    std::vector<EvalKey<Element>> loadedKeys(missing.size());
+    for (size_t i = 0; i < missing.size(); i++)
+        loadedKeys[i] = store->LoadEvalAutomorphismKey(keyTag, missing[i]);
+
+    std::lock_guard<std::mutex> lock(ks.mutex);
+    // the store was replaced while loading; the keys may not belong to the new one
+    if (ks.store != store)
+        return;
+
+    auto& keyMaps = evalAutomorphismKeyMap();
+    auto ekv      = keyMaps.find(keyTag);
+    if (ekv == keyMaps.end())
+        ekv = keyMaps.emplace(keyTag, std::make_shared<std::map<usint, EvalKey<Element>>>()).first;
+    auto& keyMap = *ekv->second;
+
+    bool added = false;
+    for (size_t i = 0; i < missing.size(); i++) {
+        usint index = missing[i];
+        // another thread may have loaded the key in the meantime
+        if (loadedKeys[i] == nullptr || keyMap.find(index) != keyMap.end())
+            continue;
+        keyMap[index] = loadedKeys[i];
+        ks.lru.push_front({keyTag, index, loadedKeys[i].get(), loadedKeys[i]->GetMemoryUsage()});
+        ks.loaded[{keyTag, index}] = ks.lru.begin();
+        ks.bytes += ks.lru.front().bytes;
+        added = true;
+    }
+
+    // so that a missing key set is reported as before
+    if (keyMap.empty()) {
+        keyMaps.erase(ekv);
+        return;
+    }
+
+    // only loading evicts, so that operations holding on to the keys they prefetched are not disturbed
+    if (!added || ks.budget == 0)
+        return;
+
+    std::set<usint> requested(indexList.begin(), indexList.end());
+    for (auto it = ks.lru.end(); it != ks.lru.begin() && ks.bytes > ks.budget;) {
+        --it;
+        if (it->keyTag == keyTag && requested.count(it->index))
+            continue;
+        auto evicted = keyMaps.find(it->keyTag);
+        if (evicted != keyMaps.end()) {
+            auto key = evicted->second->find(it->index);
+            if (key != evicted->second->end() && key->second.get() == it->key)
+                evicted->second->erase(key);
+            if (evicted->second->empty())
+                keyMaps.erase(evicted);
+        }
+        auto next = std::next(it);
+        ks.Forget(it);
+        it = next;
+    }
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::LoadEvalRotationKeys(const std::string& keyTag,
+                                                      const std::vector<int32_t>& indices) const {
+    if (GetEvalKeyStore() == nullptr)
+        return;
+
+    std::vector<usint> indexList;
+    indexList.reserve(indices.size());
+    for (auto index : indices) {
+        if (index != 0)
+            indexList.push_back(FindAutomorphismIndex(index));
+    }
+    LoadEvalAutomorphismKeys(keyTag, indexList);
+}
+
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(ConstCiphertext<Element> ciphertext, usint batchSize) const {
     if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
@@ -360,7 +512,7 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(ConstCiphertext<Element>
                       "crypto context");
 
     auto evalSumKeys = CryptoContextImpl<Element>::GetEvalSumKeyMap(ciphertext->GetKeyTag());
-    auto rv          = GetScheme()->EvalSum(ciphertext, batchSize, evalSumKeys);
+    auto rv          = GetScheme()->EvalSum(RelinearizeLazy(ciphertext), batchSize, evalSumKeys);
     return rv;
 }
 
@@ -373,7 +525,7 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumRows(ConstCiphertext<Elem
                       "Information passed to EvalSum was not generated with this "
                       "crypto context");
 
-    auto rv = GetScheme()->EvalSumRows(ciphertext, rowSize, evalSumKeys, subringDim);
+    auto rv = GetScheme()->EvalSumRows(RelinearizeLazy(ciphertext), rowSize, evalSumKeys, subringDim);
     return rv;
 }
 
@@ -388,7 +540,7 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumCols(
 
     auto evalSumKeys = CryptoContextImpl<Element>::GetEvalSumKeyMap(ciphertext->GetKeyTag());
 
-    auto rv = GetScheme()->EvalSumCols(ciphertext, rowSize, evalSumKeys, evalSumKeysRight);
+    auto rv = GetScheme()->EvalSumCols(RelinearizeLazy(ciphertext), rowSize, evalSumKeys, evalSumKeysRight);
     return rv;
 }
 
@@ -407,12 +559,216 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(ConstCiphertext<Elem
         return rv;
     }
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    LoadEvalRotationKeys(ciphertext->GetKeyTag(), {index});
+    const auto& evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
 
-    auto rv = GetScheme()->EvalAtIndex(ciphertext, index, evalAutomorphismKeys);
+    auto rv = GetScheme()->EvalAtIndex(RelinearizeLazy(ciphertext), index, evalAutomorphismKeys);
     return rv;
 }
 
+template <typename Element>
+std::vector<Ciphertext<Element>> CryptoContextImpl<Element>::EvalRotateMany(ConstCiphertext<Element> ciphertext,
+                                                                            const std::vector<int32_t>& indices,
+                                                                            bool extended) const {
+    CheckCiphertext(ciphertext);
+
+    if (extended) {
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+        if (cryptoParams == nullptr || cryptoParams->GetKeySwitchTechnique() != HYBRID)
+            OPENFHE_THROW(config_error, "EvalRotateMany in the extended basis requires CKKS with HYBRID key switching");
+    }
+
+    LoadEvalRotationKeys(ciphertext->GetKeyTag(), indices);
+    const auto& evalKeyMap = GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+
+    // all keys are checked up front so that no exception is thrown from the parallel region
+    for (auto index : indices) {
+        if (index == 0)
+            continue;
+        usint autoIndex = FindAutomorphismIndex(index);
+        if (evalKeyMap.find(autoIndex) == evalKeyMap.end())
+            OPENFHE_THROW(openfhe_error, "EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+
+    std::vector<Ciphertext<Element>> result(indices.size());
+    if (indices.empty())
+        return result;
+
+    // relinearized once here rather than in every rotation
+    ciphertext    = RelinearizeLazy(ciphertext);
+    const usint m = GetCryptoParameters()->GetElementParams()->GetCyclotomicOrder();
+    auto digits   = GetScheme()->EvalFastRotationPrecompute(ciphertext);
+
+    // the rotations are independent, so they run in parallel when there are enough of them to keep all
+    // threads busy; otherwise the parallelism inside the key switching is used
+    bool parallelRotations =
+        indices.size() > 1 && indices.size() >= static_cast<size_t>(OpenFHEParallelControls.GetMachineThreads());
+#pragma omp parallel for if (parallelRotations) schedule(dynamic)
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (!extended)
+            result[i] = GetScheme()->EvalFastRotation(ciphertext, indices[i], m, digits);
+        else if (indices[i] == 0)
+            result[i] = GetScheme()->KeySwitchExt(ciphertext, true);
+        else
+            result[i] = GetScheme()->EvalFastRotationExt(ciphertext, indices[i], digits, true, evalKeyMap);
+    }
+
+    return result;
+}
+
+template <typename Element>
+uint32_t CryptoContextImpl<Element>::GetDefaultSlots(uint32_t slots) const {
+    if (slots != 0)
+        return slots;
+    auto batchSize = GetEncodingParams()->GetBatchSize();
+    return (batchSize == 0) ? GetRingDimension() / 2 : batchSize;
+}
+
+template <typename Element>
+std::shared_ptr<LinearTransformPrecom> CryptoContextImpl<Element>::EvalLinearTransformPrecompute(
+    const std::vector<std::vector<double>>& A, uint32_t slots, uint32_t bStep) const {
+    if (GetCryptoParameters() == nullptr ||
+        std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(GetCryptoParameters()) == nullptr)
+        OPENFHE_THROW(config_error, "EvalLinearTransformPrecompute is only supported for CKKS");
+
+    return LinearTransformPrecom::FromMatrix(A, GetDefaultSlots(slots), bStep);
+}
+
+template <typename Element>
+std::shared_ptr<LinearTransformPrecom> CryptoContextImpl<Element>::EvalLinearTransformPrecompute(
+    uint32_t dim, const std::map<uint32_t, std::vector<double>>& diagonals, uint32_t slots, uint32_t bStep) const {
+    if (GetCryptoParameters() == nullptr ||
+        std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(GetCryptoParameters()) == nullptr)
+        OPENFHE_THROW(config_error, "EvalLinearTransformPrecompute is only supported for CKKS");
+
+    return std::make_shared<LinearTransformPrecom>(dim, GetDefaultSlots(slots), diagonals, bStep);
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalLinearTransform(
+    const std::shared_ptr<LinearTransformPrecom>& precom, ConstCiphertext<Element> ciphertext) const {
+    CheckCiphertext(ciphertext);
+
+    if (ciphertext->GetSlots() != precom->GetSlots())
+        OPENFHE_THROW(config_error, "The linear transform was prepared for " + std::to_string(precom->GetSlots()) +
+                                        " slots, but the ciphertext has " + std::to_string(ciphertext->GetSlots()));
+
+    const auto& indices = precom->GetDiagonalIndices();
+    if (indices.empty())
+        OPENFHE_THROW(config_error, "The matrix passed to EvalLinearTransform has no nonzero entries");
+
+    // the diagonals are encoded at the level the products are computed at
+    auto ct                 = RelinearizeLazy(ciphertext)->Clone();
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ct->GetCryptoParameters());
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && cryptoParams->GetScalingTechnique() != NORESCALE &&
+        ct->GetNoiseScaleDeg() == 2)
+        GetScheme()->ModReduceInternalInPlace(ct, BASE_NUM_LEVELS_TO_DROP);
+
+    // replicate the input over all slots so that rotations by less than dim are cyclic in dim
+    for (auto step : precom->GetReplicationSteps())
+        EvalAddInPlace(ct, EvalRotate(ct, step));
+
+    // all keys are checked up front so that no exception is thrown from the parallel regions
+    LoadEvalRotationKeys(ciphertext->GetKeyTag(), precom->GetRotationIndices());
+    const auto& evalKeyMap = GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    for (auto index : precom->GetRotationIndices()) {
+        usint autoIndex = FindAutomorphismIndex(index);
+        if (evalKeyMap.find(autoIndex) == evalKeyMap.end())
+            OPENFHE_THROW(openfhe_error, "EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+
+    uint32_t level = ct->GetLevel();
+    auto encoded   = precom->GetEncodedDiagonals(level);
+    if (encoded.empty()) {
+        encoded.resize(indices.size());
+        // the first encoding initializes the shared FFT tables
+        encoded[0] = MakeCKKSPackedPlaintext(precom->GetSlotVector(0), 1, level, nullptr, precom->GetSlots());
+#pragma omp parallel for
+        for (size_t pos = 1; pos < indices.size(); pos++)
+            encoded[pos] = MakeCKKSPackedPlaintext(precom->GetSlotVector(pos), 1, level, nullptr, precom->GetSlots());
+        precom->SetEncodedDiagonals(level, encoded);
+    }
+
+    const uint32_t bStep   = precom->GetBabyStep();
+    const auto& babySteps  = precom->GetBabySteps();
+    const auto& giantSteps = precom->GetGiantSteps();
+    auto rotated           = EvalRotateMany(ct, babySteps);
+
+    // the diagonal indices are sorted, so each giant step owns a contiguous range of them
+    std::vector<size_t> giantBegin(giantSteps.size() + 1, indices.size());
+    for (size_t pos = indices.size(); pos-- > 0;) {
+        auto j = std::lower_bound(giantSteps.begin(), giantSteps.end(),
+                                  static_cast<int32_t>(bStep * (indices[pos] / bStep)));
+        giantBegin[j - giantSteps.begin()] = pos;
+    }
+
+    // the keys were loaded and the diagonals encoded at the level of the products above, so the products and
+    // rotations call the scheme directly and take neither the key store nor the plaintext cache lock
+    std::vector<Ciphertext<Element>> partial(giantSteps.size());
+    bool parallelGiantSteps =
+        giantSteps.size() > 1 && giantSteps.size() >= static_cast<size_t>(OpenFHEParallelControls.GetMachineThreads());
+#pragma omp parallel for if (parallelGiantSteps) schedule(dynamic)
+    for (size_t j = 0; j < giantSteps.size(); j++) {
+        Ciphertext<Element> inner;
+        for (size_t pos = giantBegin[j]; pos < giantBegin[j + 1]; pos++) {
+            auto i = std::lower_bound(babySteps.begin(), babySteps.end(), static_cast<int32_t>(indices[pos] % bStep));
+            auto term = GetScheme()->EvalMult(rotated[i - babySteps.begin()], encoded[pos]);
+            if (inner == nullptr)
+                inner = term;
+            else
+                EvalAddInPlace(inner, term);
+        }
+        partial[j] = (giantSteps[j] == 0) ? inner : GetScheme()->EvalAtIndex(inner, giantSteps[j], evalKeyMap);
+    }
+
+    for (size_t j = 1; j < partial.size(); j++)
+        EvalAddInPlace(partial[0], partial[j]);
+
+    return partial[0];
+}
+
+template <typename Element>
+std::shared_ptr<MatMulPrecom> CryptoContextImpl<Element>::EvalMatMulPrecompute(uint32_t d, uint32_t slots) const {
+    if (GetCryptoParameters() == nullptr ||
+        std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(GetCryptoParameters()) == nullptr)
+        OPENFHE_THROW(config_error, "EvalMatMulPrecompute is only supported for CKKS");
+
+    return std::make_shared<MatMulPrecom>(d, GetDefaultSlots(slots));
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalMatMul(const std::shared_ptr<MatMulPrecom>& precom,
+                                                           ConstCiphertext<Element> ciphertext1,
+                                                           ConstCiphertext<Element> ciphertext2) const {
+    CheckCiphertext(ciphertext1);
+    CheckCiphertext(ciphertext2);
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext1->GetCryptoParameters());
+    bool manual             = cryptoParams->GetScalingTechnique() == FIXEDMANUAL;
+
+    // A[i][i + j] and B[i + j][j]
+    auto ctA = EvalLinearTransform(precom->GetSigma(), ciphertext1);
+    auto ctB = EvalLinearTransform(precom->GetTau(), ciphertext2);
+    if (manual) {
+        RescaleInPlace(ctA);
+        RescaleInPlace(ctB);
+    }
+
+    // sum over k of A[i][i + j + k] * B[i + j + k][j]
+    auto result = EvalMult(ctA, ctB);
+    for (uint32_t k = 1; k < precom->GetDimension(); k++) {
+        auto ctAk = EvalLinearTransform(precom->GetColumnShift(k), ctA);
+        auto ctBk = EvalLinearTransform(precom->GetRowShift(k), ctB);
+        if (manual) {
+            RescaleInPlace(ctAk);
+            RescaleInPlace(ctBk);
+        }
+        EvalAddInPlace(result, EvalMult(ctAk, ctBk));
+    }
+
+    return result;
+}
+
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
     const std::vector<Ciphertext<Element>>& ciphertextVector) const {
@@ -423,7 +779,14 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
 
     auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertextVector[0]->GetKeyTag());
 
-    auto rv = GetScheme()->EvalMerge(ciphertextVector, evalAutomorphismKeys);
+    // the rotations in EvalMerge need two-element ciphertexts
+    std::vector<Ciphertext<Element>> ciphertexts(ciphertextVector);
+    for (auto& ciphertext : ciphertexts) {
+        if (ciphertext->GetElements().size() > 2)
+            ciphertext = Relinearize(ciphertext);
+    }
+
+    auto rv = GetScheme()->EvalMerge(ciphertexts, evalAutomorphismKeys);
 
     return rv;
 }
@@ -439,7 +802,7 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
     auto evalSumKeys = CryptoContextImpl<Element>::GetEvalSumKeyMap(ct1->GetKeyTag());
     auto ek          = GetEvalMultKeyVector(ct1->GetKeyTag());
 
-    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys, ek[0]);
+    auto rv = GetScheme()->EvalInnerProduct(RelinearizeLazy(ct1), RelinearizeLazy(ct2), batchSize, evalSumKeys, ek[0]);
     return rv;
 }
 
@@ -453,7 +816,7 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
 
     auto evalSumKeys = CryptoContextImpl<Element>::GetEvalSumKeyMap(ct1->GetKeyTag());
 
-    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys);
+    auto rv = GetScheme()->EvalInnerProduct(RelinearizeLazy(ct1), ct2, batchSize, evalSumKeys);
     return rv;
 }
 
@@ -521,6 +884,47 @@ DecryptResult CryptoContextImpl<Element>::Decrypt(ConstCiphertext<Element> ciphe
     return result;
 }
 
+template <typename Element>
+std::vector<Plaintext> CryptoContextImpl<Element>::MakeCKKSPackedPlaintexts(
+    const std::vector<std::vector<double>>& values, size_t depth, uint32_t level,
+    const std::shared_ptr<ParmType> params, usint slots) const {
+    std::vector<Plaintext> plaintexts(values.size());
+    if (values.empty())
+        return plaintexts;
+
+    // the first encoding validates the arguments and initializes the shared FFT tables
+    plaintexts[0] = MakeCKKSPackedPlaintext(values[0], depth, level, params, slots);
+
+    ThreadException e;
+#pragma omp parallel for if (values.size() > 2) schedule(dynamic)
+    for (size_t i = 1; i < values.size(); i++) {
+        e.Run([&]() { plaintexts[i] = MakeCKKSPackedPlaintext(values[i], depth, level, params, slots); });
+    }
+    e.Rethrow();
+
+    return plaintexts;
+}
+
+template <typename Element>
+std::vector<DecryptResult> CryptoContextImpl<Element>::Decrypt(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                               const PrivateKey<Element> privateKey,
+                                                               std::vector<Plaintext>* plaintexts) {
+    if (plaintexts == nullptr)
+        OPENFHE_THROW(config_error, "plaintexts passed to Decrypt is empty");
+
+    std::vector<DecryptResult> results(ciphertexts.size());
+    plaintexts->assign(ciphertexts.size(), nullptr);
+
+    ThreadException e;
+#pragma omp parallel for if (ciphertexts.size() > 1) schedule(dynamic)
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        e.Run([&]() { results[i] = Decrypt(ciphertexts[i], privateKey, &(*plaintexts)[i]); });
+    }
+    e.Rethrow();
+
+    return results;
+}
+
 template <typename Element>
 DecryptResult CryptoContextImpl<Element>::MultipartyDecryptFusion(
     const std::vector<Ciphertext<Element>>& partialCiphertextVec, Plaintext* plaintext) const {
@@ -619,8 +1023,8 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalDivide(ConstCiphertext<Eleme
 
 template <typename Element>
 void CryptoContextImpl<Element>::EvalBootstrapSetup(std::vector<uint32_t> levelBudget, std::vector<uint32_t> dim1,
-                                                    uint32_t numSlots, uint32_t correctionFactor) {
-    GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, numSlots, correctionFactor);
+                                                    uint32_t numSlots, uint32_t correctionFactor, bool precompute) {
+    GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, numSlots, correctionFactor, precompute);
 }
 
 template <typename Element>
@@ -654,9 +1058,451 @@ void CryptoContextImpl<Element>::EvalBootstrapKeyGen(const PrivateKey<Element> p
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalBootstrap(ConstCiphertext<Element> ciphertext,
                                                               uint32_t numIterations, uint32_t precision) const {
+    // prefetch all keys, so that the rotations inside bootstrapping do not load or evict any
+    auto fhe = std::dynamic_pointer_cast<FHECKKSRNS>(GetScheme()->GetFHE());
+    if (fhe != nullptr && ciphertext != nullptr && GetEvalKeyStore() != nullptr) {
+        uint32_t M = GetCyclotomicOrder();
+        std::vector<usint> indexList;
+        for (auto index : fhe->FindBootstrapRotationIndices(ciphertext->GetSlots(), M))
+            indexList.push_back(FindAutomorphismIndex(index));
+        indexList.push_back(M - 1);
+        LoadEvalAutomorphismKeys(ciphertext->GetKeyTag(), indexList);
+    }
+    if (ciphertext != nullptr)
+        ciphertext = RelinearizeLazy(ciphertext);
     return GetScheme()->EvalBootstrap(ciphertext, numIterations, precision);
 }
 
+template <typename Element>
+void CryptoContextImpl<Element>::SetPlaintextCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_ptxtCacheMutex);
+    m_ptxtCacheBudget = bytes;
+    TrimPlaintextCache();
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::TrimPlaintextCache() const {
+    while (!m_ptxtCache.empty() && m_ptxtCacheBytes > m_ptxtCacheBudget) {
+        m_ptxtCacheBytes -= m_ptxtCache.back().bytes;
+        m_ptxtCacheIndex.erase(m_ptxtCache.back().key);
+        m_ptxtCache.pop_back();
+    }
+}
+
+template <typename Element>
+ConstPlaintext CryptoContextImpl<Element>::GetCachedPlaintext(ConstCiphertext<Element> ciphertext,
+                                                              ConstPlaintext plaintext, bool forMult) const {
+    if (m_ptxtCacheBudget.load() == 0)
+        return plaintext;
+    if (plaintext->GetEncodingType() != CKKS_PACKED_ENCODING)
+        return plaintext;
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(GetCryptoParameters());
+    if (!cryptoParams)
+        return plaintext;
+
+    // the level and depth AdjustForMultInPlace/AdjustForAddOrSubInPlace bring the plaintext to
+    uint32_t level = ciphertext->GetLevel();
+    size_t depth   = plaintext->GetNoiseScaleDeg();
+    switch (cryptoParams->GetScalingTechnique()) {
+        case FIXEDMANUAL:
+            break;
+        case FIXEDAUTO:
+        case FLEXIBLEAUTO:
+            if (forMult) {
+                if (ciphertext->GetNoiseScaleDeg() == 2)
+                    ++level;
+                depth = 1;
+            }
+            else {
+                depth = ciphertext->GetNoiseScaleDeg();
+            }
+            break;
+        default:
+            // FLEXIBLEAUTOEXT encodes level 0 differently and NORESCALE never adjusts
+            return plaintext;
+    }
+
+    // a plaintext above the target level is left to the scheme, which lowers the ciphertext instead
+    if (plaintext->GetLevel() > level || (plaintext->GetLevel() == level && plaintext->GetNoiseScaleDeg() == depth))
+        return plaintext;
+    if (level >= cryptoParams->GetElementParams()->GetParams().size())
+        return plaintext;
+
+    const auto& value = plaintext->GetCKKSPackedValue();
+    usint slots       = plaintext->GetSlots();
+
+    size_t hash  = 0;
+    auto combine = [&hash](size_t h) {
+        hash ^= h + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+    for (const auto& v : value) {
+        combine(std::hash<double>{}(v.real()));
+        combine(std::hash<double>{}(v.imag()));
+    }
+    auto key = std::make_tuple(hash, level, depth, slots);
+
+    ConstPlaintext encoded;
+    {
+        std::lock_guard<std::mutex> lock(m_ptxtCacheMutex);
+        auto found = m_ptxtCacheIndex.find(key);
+        if (found != m_ptxtCacheIndex.end() && found->second->value == value) {
+            m_ptxtCache.splice(m_ptxtCache.begin(), m_ptxtCache, found->second);
+            encoded = found->second->plaintext;
+        }
+    }
+
+    // addition needs matching scaling factors; the scheme would force them equal, so only
+    // use the re-encoded plaintext if it already agrees with the ciphertext
+    auto compatible = [&](const ConstPlaintext& candidate) {
+        if (forMult)
+            return true;
+        double scf = ciphertext->GetScalingFactor();
+        return std::fabs(candidate->GetScalingFactor() - scf) <= 1e-12 * scf;
+    };
+
+    if (!encoded) {
+        // encode outside of the lock; a concurrent caller may do the same, in which case
+        // the entry inserted last wins
+        Plaintext fresh = MakeCKKSPackedPlaintext(value, depth, level, nullptr, slots);
+        fresh->SetFormat(EVALUATION);
+        encoded = fresh;
+        // a plaintext the caller cannot use is not kept
+        if (!compatible(encoded))
+            return plaintext;
+
+        size_t bytes = fresh->GetMemoryUsage() + value.size() * sizeof(value[0]);
+
+        std::lock_guard<std::mutex> lock(m_ptxtCacheMutex);
+        if (bytes <= m_ptxtCacheBudget) {
+            auto found = m_ptxtCacheIndex.find(key);
+            if (found != m_ptxtCacheIndex.end()) {
+                m_ptxtCacheBytes -= found->second->bytes;
+                m_ptxtCache.erase(found->second);
+                m_ptxtCacheIndex.erase(found);
+            }
+            m_ptxtCache.push_front({key, value, encoded, bytes});
+            m_ptxtCacheIndex[key] = m_ptxtCache.begin();
+            m_ptxtCacheBytes += bytes;
+            TrimPlaintextCache();
+        }
+        return encoded;
+    }
+
+    if (!compatible(encoded))
+        return plaintext;
+    return encoded;
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::SerializeFlat(ConstCiphertext<Element> ciphertext, std::ostream& os,
+                                               bool bitPacked) const {
+    CheckCiphertext(ciphertext);
+
+    const auto& elements = ciphertext->GetElements();
+    Serial::WriteFlat(os, Serial::FLAT_TAG_CIPHERTEXT);
+    Serial::WriteFlat(os, static_cast<uint32_t>(1));
+    Serial::WriteFlat(os, static_cast<uint32_t>(elements.size()));
+    Serial::WriteFlat(os, static_cast<uint32_t>(ciphertext->GetNoiseScaleDeg()));
+    Serial::WriteFlat(os, static_cast<uint32_t>(ciphertext->GetLevel()));
+    Serial::WriteFlat(os, static_cast<uint32_t>(ciphertext->GetHopLevel()));
+    Serial::WriteFlat(os, static_cast<uint32_t>(ciphertext->GetEncodingType()));
+    Serial::WriteFlat(os, static_cast<uint32_t>(ciphertext->GetSlots()));
+    Serial::WriteFlat(os, ciphertext->GetScalingFactor());
+    Serial::WriteFlat(os, ciphertext->GetScalingFactorInt());
+    Serial::WriteFlatString(os, ciphertext->GetKeyTag());
+    for (const auto& element : elements)
+        element.SerializeFlat(os, bitPacked);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::SerializeCompressed(ConstCiphertext<Element> ciphertext, std::ostream& os,
+                                                     uint32_t towersLeft) const {
+    CheckCiphertext(ciphertext);
+    if (towersLeft > 0 && towersLeft < ciphertext->GetElements()[0].GetNumOfElements())
+        SerializeFlat(Compress(ciphertext, towersLeft), os, true);
+    else
+        SerializeFlat(ciphertext, os, true);
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::DeserializeCiphertextFlat(std::istream& is) const {
+    Serial::CheckFlatTag(is, Serial::FLAT_TAG_CIPHERTEXT, "Ciphertext");
+    const auto version = Serial::ReadFlat<uint32_t>(is);
+    if (version > 1)
+        OPENFHE_THROW(deserialize_error, "flat ciphertext version " + std::to_string(version) +
+                                             " is from a later version of the library");
+    const auto numElements   = Serial::ReadFlat<uint32_t>(is);
+    const auto noiseScaleDeg = Serial::ReadFlat<uint32_t>(is);
+    const auto level         = Serial::ReadFlat<uint32_t>(is);
+    const auto hopLevel      = Serial::ReadFlat<uint32_t>(is);
+    const auto encodingType  = static_cast<PlaintextEncodings>(Serial::ReadFlat<uint32_t>(is));
+    const auto slots         = Serial::ReadFlat<uint32_t>(is);
+    const auto scalingFactor = Serial::ReadFlat<double>(is);
+    const auto scalingInt    = Serial::ReadFlat<NativeInteger>(is);
+    const auto keyTag        = Serial::ReadFlatString(is);
+    if (numElements == 0 || numElements > Serial::FLAT_MAX_ELEMENTS)
+        OPENFHE_THROW(deserialize_error, "a flat ciphertext cannot have " + std::to_string(numElements) + " elements");
+
+    // the elements after the first share its parameters
+    std::vector<Element> elements(numElements);
+    for (uint32_t i = 0; i < numElements; i++)
+        elements[i].DeserializeFlat(is, i == 0 ? GetElementParams() : elements[0].GetParams());
+
+    auto ciphertext = std::make_shared<CiphertextImpl<Element>>(GetContextForPointer(this), keyTag, encodingType);
+    ciphertext->SetElements(std::move(elements));
+    ciphertext->SetNoiseScaleDeg(noiseScaleDeg);
+    ciphertext->SetLevel(level);
+    ciphertext->SetHopLevel(hopLevel);
+    ciphertext->SetScalingFactor(scalingFactor);
+    ciphertext->SetScalingFactorInt(scalingInt);
+    ciphertext->SetSlots(slots);
+    return ciphertext;
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::SerializeFlat(const EvalKey<Element> evalKey, std::ostream& os) const {
+    CheckKey(evalKey);
+
+    const auto relinKey = std::dynamic_pointer_cast<EvalKeyRelinImpl<Element>>(evalKey);
+    if (relinKey == nullptr)
+        OPENFHE_THROW(not_implemented_error, "SerializeFlat supports relinearization and automorphism keys only");
+
+    const auto& b = relinKey->GetBVector();
+    Serial::WriteFlat(os, Serial::FLAT_TAG_EVALKEY);
+    Serial::WriteFlat(os, static_cast<uint32_t>(1));
+    Serial::WriteFlat(os, static_cast<uint32_t>(b.size()));
+    Serial::WriteFlat(os, static_cast<uint32_t>(relinKey->HasASeed()));
+    Serial::WriteFlatString(os, relinKey->GetKeyTag());
+    // Vector A is replaced by its seed
+    if (relinKey->HasASeed()) {
+        const PRNGSeed seed = relinKey->GetASeed();
+        Serial::WriteFlat(os, seed.data(), seed.size());
+    }
+    for (const auto& element : b)
+        element.SerializeFlat(os);
+    if (!relinKey->HasASeed()) {
+        for (const auto& element : relinKey->GetAVector())
+            element.SerializeFlat(os);
+    }
+}
+
+template <typename Element>
+EvalKey<Element> CryptoContextImpl<Element>::DeserializeEvalKeyFlat(std::istream& is) const {
+    Serial::CheckFlatTag(is, Serial::FLAT_TAG_EVALKEY, "EvalKey");
+    const auto version = Serial::ReadFlat<uint32_t>(is);
+    if (version > 1)
+        OPENFHE_THROW(deserialize_error, "flat EvalKey version " + std::to_string(version) +
+                                             " is from a later version of the library");
+    const auto count  = Serial::ReadFlat<uint32_t>(is);
+    const bool seeded = Serial::ReadFlat<uint32_t>(is) != 0;
+    const auto keyTag = Serial::ReadFlatString(is);
+    PRNGSeed seed{};
+    if (seeded)
+        Serial::ReadFlat(is, seed.data(), seed.size());
+
+    // hybrid keys live in the extended basis QP
+    auto params             = GetElementParams();
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(GetCryptoParameters());
+    if (cryptoParams != nullptr && cryptoParams->GetKeySwitchTechnique() == HYBRID)
+        params = cryptoParams->GetParamsQP();
+
+    // there is at most one digit per bit of every tower
+    if (count == 0 || count > params->GetParams().size() * sizeof(NativeInteger) * 8)
+        OPENFHE_THROW(deserialize_error, "a flat EvalKey cannot have " + std::to_string(count) + " digits");
+
+    std::vector<Element> b(count);
+    for (uint32_t i = 0; i < count; i++)
+        b[i].DeserializeFlat(is, i == 0 ? params : b[0].GetParams());
+
+    std::vector<Element> a(count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (seeded)
+            a[i] = EvalKeyRelinImpl<Element>::ExpandAVector(seed, i, b[i].GetParams());
+        else
+            a[i].DeserializeFlat(is, b[i].GetParams());
+    }
+
+    auto evalKey = std::make_shared<EvalKeyRelinImpl<Element>>(GetContextForPointer(this));
+    evalKey->SetKeyTag(keyTag);
+    evalKey->SetAVector(std::move(a));
+    evalKey->SetBVector(std::move(b));
+    if (seeded)
+        evalKey->SetASeed(seed);
+    return evalKey;
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::SerializeEvalKeyBundleFlat(
+    std::ostream& os, FlatKeyBundle kind, const std::string& keyTag,
+    const std::vector<std::pair<usint, EvalKey<Element>>>& keys) const {
+    Serial::WriteFlat(os, Serial::FLAT_TAG_KEYBUNDLE);
+    Serial::WriteFlat(os, static_cast<uint32_t>(1));
+    Serial::WriteFlat(os, static_cast<uint32_t>(kind));
+    Serial::WriteFlat(os, static_cast<uint32_t>(keys.size()));
+    Serial::WriteFlatString(os, keyTag);
+    // the size of every record lets the reader skip keys without decoding them
+    for (const auto& key : keys) {
+        std::ostringstream record;
+        SerializeFlat(key.second, record);
+        const std::string bytes = record.str();
+        Serial::WriteFlat(os, static_cast<uint64_t>(key.first));
+        Serial::WriteFlat(os, static_cast<uint64_t>(bytes.size()));
+        Serial::WriteFlat(os, bytes.data(), bytes.size());
+    }
+}
+
+template <typename Element>
+size_t CryptoContextImpl<Element>::DeserializeEvalKeyBundleFlat(
+    std::istream& is, FlatKeyBundle kind, const std::function<bool(usint)>& filter,
+    const std::function<void(const std::string&, usint, EvalKey<Element>)>& insert) const {
+    Serial::CheckFlatTag(is, Serial::FLAT_TAG_KEYBUNDLE, "key bundle");
+    const auto version = Serial::ReadFlat<uint32_t>(is);
+    if (version > 1)
+        OPENFHE_THROW(deserialize_error, "flat key bundle version " + std::to_string(version) +
+                                             " is from a later version of the library");
+    if (Serial::ReadFlat<uint32_t>(is) != kind)
+        OPENFHE_THROW(deserialize_error, "the flat key bundle holds a different kind of keys");
+    uint32_t remaining = Serial::ReadFlat<uint32_t>(is);
+    const auto keyTag  = Serial::ReadFlatString(is);
+
+    // one record per thread is held in memory at a time
+    const size_t batchSize = std::max(OpenFHEParallelControls.GetMachineThreads(), 1);
+    std::vector<std::pair<usint, std::string>> records;
+    std::vector<EvalKey<Element>> keys;
+    size_t inserted = 0;
+    while (remaining > 0) {
+        records.clear();
+        while (remaining > 0 && records.size() < batchSize) {
+            remaining--;
+            const auto index = static_cast<usint>(Serial::ReadFlat<uint64_t>(is));
+            const auto size  = Serial::ReadFlat<uint64_t>(is);
+            if (size > static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()))
+                OPENFHE_THROW(deserialize_error, "a record of the flat key bundle is larger than any stream");
+            if (filter && !filter(index)) {
+                if (!is.ignore(static_cast<std::streamsize>(size)) || is.gcount() != static_cast<std::streamsize>(size))
+                    OPENFHE_THROW(deserialize_error, "unexpected end of a flat binary stream");
+                continue;
+            }
+            std::string bytes;
+            Serial::ReadFlatBytes(is, bytes, size);
+            records.emplace_back(index, std::move(bytes));
+        }
+
+        keys.assign(records.size(), nullptr);
+        ThreadException e;
+#pragma omp parallel for if (records.size() > 1) schedule(dynamic)
+        for (size_t i = 0; i < records.size(); i++) {
+            e.Run([&, i] {
+                Serial::FlatBuffer buffer(records[i].second.data(), records[i].second.size());
+                std::istream record(&buffer);
+                keys[i] = DeserializeEvalKeyFlat(record);
+                std::string().swap(records[i].second);
+            });
+        }
+        e.Rethrow();
+
+        for (size_t i = 0; i < records.size(); i++)
+            insert(keyTag, records[i].first, std::move(keys[i]));
+        inserted += records.size();
+    }
+    return inserted;
+}
+
+template <typename Element>
+bool CryptoContextImpl<Element>::SerializeEvalMultKeyFlat(std::ostream& os, const std::string& keyTag) const {
+    auto ekv = GetAllEvalMultKeys().find(keyTag);
+    if (ekv == GetAllEvalMultKeys().end())
+        return false;
+
+    std::vector<std::pair<usint, EvalKey<Element>>> keys;
+    for (usint i = 0; i < ekv->second.size(); i++)
+        keys.emplace_back(i, ekv->second[i]);
+    SerializeEvalKeyBundleFlat(os, FLAT_BUNDLE_EVALMULT, keyTag, keys);
+    return true;
+}
+
+template <typename Element>
+bool CryptoContextImpl<Element>::SerializeEvalAutomorphismKeyFlat(std::ostream& os, const std::string& keyTag) const {
+    auto ekv = GetAllEvalAutomorphismKeys().find(keyTag);
+    if (ekv == GetAllEvalAutomorphismKeys().end() || ekv->second == nullptr)
+        return false;
+
+    std::vector<std::pair<usint, EvalKey<Element>>> keys(ekv->second->begin(), ekv->second->end());
+    SerializeEvalKeyBundleFlat(os, FLAT_BUNDLE_AUTOMORPHISM, keyTag, keys);
+    return true;
+}
+
+template <typename Element>
+size_t CryptoContextImpl<Element>::DeserializeEvalMultKeyFlat(std::istream& is) const {
+    std::string keyTag;
+    std::vector<EvalKey<Element>> evalKeyVec;
+    const size_t count = DeserializeEvalKeyBundleFlat(
+        is, FLAT_BUNDLE_EVALMULT, nullptr, [&](const std::string& tag, usint index, EvalKey<Element> key) {
+            if (index != evalKeyVec.size())
+                OPENFHE_THROW(deserialize_error, "the EvalMult keys of a flat key bundle are out of order");
+            keyTag = tag;
+            evalKeyVec.push_back(std::move(key));
+        });
+
+    if (count > 0)
+        GetAllEvalMultKeys()[keyTag] = std::move(evalKeyVec);
+    return count;
+}
+
+template <typename Element>
+size_t CryptoContextImpl<Element>::DeserializeEvalAutomorphismKeyFlat(
+    std::istream& is, const std::function<bool(usint)>& filter) const {
+    std::map<usint, EvalKey<Element>>* keyMap = nullptr;
+    return DeserializeEvalKeyBundleFlat(
+        is, FLAT_BUNDLE_AUTOMORPHISM, filter, [&](const std::string& keyTag, usint index, EvalKey<Element> key) {
+            if (keyMap == nullptr) {
+                auto& ekv = GetAllEvalAutomorphismKeys()[keyTag];
+                if (ekv == nullptr)
+                    ekv = std::make_shared<std::map<usint, EvalKey<Element>>>();
+                keyMap = ekv.get();
+            }
+            (*keyMap)[index] = std::move(key);
+        });
+}
+
+template <typename Element>
+std::map<std::string, size_t> CryptoContextImpl<Element>::GetMemoryUsage() const {
+    size_t multKeys = 0;
+    for (const auto& entry : GetAllEvalMultKeys()) {
+        for (const auto& key : entry.second) {
+            if (key && key->GetCryptoContext().get() == this)
+                multKeys += key->GetMemoryUsage();
+        }
+    }
+
+    auto keyMapUsage = [this](const std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& maps) {
+        size_t bytes = 0;
+        for (const auto& entry : maps) {
+            if (!entry.second)
+                continue;
+            for (const auto& key : *entry.second) {
+                if (key.second && key.second->GetCryptoContext().get() == this)
+                    bytes += key.second->GetMemoryUsage();
+            }
+        }
+        return bytes;
+    };
+
+    size_t ptxtCacheBytes;
+    {
+        std::lock_guard<std::mutex> lock(m_ptxtCacheMutex);
+        ptxtCacheBytes = m_ptxtCacheBytes;
+    }
+
+    return {{"EvalMultKeys", multKeys},
+            {"EvalSumKeys", keyMapUsage(GetAllEvalSumKeys())},
+            {"EvalAutomorphismKeys", keyMapUsage(GetAllEvalAutomorphismKeys())},
+            {"FHEPrecomputations", GetScheme()->GetFHEMemoryUsage()},
+            {"NTTTables", ChineseRemainderTransformFTT<NativeVector>::GetMemoryUsage()},
+            {"PlaintextCache", ptxtCacheBytes}};
+}
+
 }  // namespace lbcrypto
 
 // the code below is from cryptocontext-impl.cpp
@@ -33,29 +33,77 @@
 #include "schemebase/base-scheme.h"
 #include "scheme/scheme-id.h"
 
+#include <algorithm>
+
 namespace lbcrypto {
 
 template <typename Element>
 std::vector<CryptoContext<Element>> CryptoContextFactory<Element>::AllContexts;
+template <typename Element>
+std::unordered_multimap<size_t, CryptoContext<Element>> CryptoContextFactory<Element>::ContextIndex;
+template <typename Element>
+std::shared_mutex CryptoContextFactory<Element>::ContextsMutex;
 
 template <typename Element>
 void CryptoContextFactory<Element>::ReleaseAllContexts() {
+    std::unique_lock<std::shared_mutex> lock(ContextsMutex);
     AllContexts.clear();
+    ContextIndex.clear();
+}
+
+template <typename Element>
+bool CryptoContextFactory<Element>::ReleaseContext(const CryptoContext<Element>& cc) {
+    if (cc == nullptr)
+        return false;
+
+    std::unique_lock<std::shared_mutex> lock(ContextsMutex);
+    auto it = std::find(AllContexts.begin(), AllContexts.end(), cc);
+    if (it == AllContexts.end())
+        return false;
+    AllContexts.erase(it);
+
+    for (auto entry = ContextIndex.begin(); entry != ContextIndex.end(); ++entry) {
+        if (entry->second == cc) {
+            ContextIndex.erase(entry);
+            break;
+        }
+    }
+    return true;
 }
 
 template <typename Element>
 int CryptoContextFactory<Element>::GetContextCount() {
+    std::shared_lock<std::shared_mutex> lock(ContextsMutex);
     return AllContexts.size();
 }
 
+template <typename Element>
+size_t CryptoContextFactory<Element>::ParameterHash(const CryptoParametersBase<Element>& params) {
+    size_t seed  = 0;
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+
+    const auto& elementParams = params.GetElementParams();
+    if (elementParams != nullptr) {
+        combine(elementParams->GetCyclotomicOrder());
+        combine(elementParams->GetRingDimension());
+        for (const auto& tower : elementParams->GetParams())
+            combine(std::hash<uint64_t>{}(tower->GetModulus().ConvertToInt()));
+    }
+    // the encoding parameters are left out: they can be replaced in a registered context
+    // (e.g. to change the batch size), which must not move the context to another bucket
+    return seed;
+}
+
 template <typename Element>
 CryptoContext<Element> CryptoContextFactory<Element>::FindContext(std::shared_ptr<CryptoParametersBase<Element>> params,
     std::shared_ptr<SchemeBase<Element>> scheme) {
-    for (CryptoContext<Element> cc : CryptoContextFactory<Element>::AllContexts) {
+    // the caller holds ContextsMutex
+    auto range = ContextIndex.equal_range(ParameterHash(*params));
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        const CryptoContext<Element>& cc = entry->second;
         if (*cc->GetScheme().get() == *scheme.get() && *cc->GetCryptoParameters().get() == *params.get()) {
-            if (cc->GetEncodingParams()->GetPlaintextRootOfUnity() != 0) {
-                PackedEncoding::SetParams(cc->GetCyclotomicOrder(), cc->GetEncodingParams());
-            }
             return cc;
         }
     }
@@ -65,22 +113,38 @@ CryptoContext<Element> CryptoContextFactory<Element>::FindContext(std::shared_pt
 
 template <typename Element>
 void CryptoContextFactory<Element>::AddContext(CryptoContext<Element> cc) {
+    // the caller holds ContextsMutex exclusively
     AllContexts.push_back(cc);
-
-    if (cc->GetEncodingParams()->GetPlaintextRootOfUnity() != 0) {
-        PackedEncoding::SetParams(cc->GetCyclotomicOrder(), cc->GetEncodingParams());
-    }
+    ContextIndex.emplace(ParameterHash(*cc->GetCryptoParameters()), cc);
 }
 
 template <typename Element>
 CryptoContext<Element> CryptoContextFactory<Element>::GetContext(std::shared_ptr<CryptoParametersBase<Element>> params,
                                                                  std::shared_ptr<SchemeBase<Element>> scheme,
                                                                  SCHEME schemeId) {
-    CryptoContext<Element> cc = FindContext(params, scheme);
-    // if the context is not found we should create one
+    CryptoContext<Element> cc;
+    bool added = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(ContextsMutex);
+        cc = FindContext(params, scheme);
+    }
+    // if the context is not found we should create one; another thread may have
+    // registered an equal context in the meantime, so search again under the exclusive lock
     if (nullptr == cc) {
-        cc = std::make_shared<CryptoContextImpl<Element>>(params, scheme, schemeId);
-        AddContext(cc);
+        std::unique_lock<std::shared_mutex> lock(ContextsMutex);
+        cc = FindContext(params, scheme);
+        if (nullptr == cc) {
+            cc = std::make_shared<CryptoContextImpl<Element>>(params, scheme, schemeId);
+            AddContext(cc);
+            added = true;
+        }
+    }
+
+    // the packed encoding tables are attached to the encoding parameters of the context;
+    // a known context only needs them rebuilt if its encoding parameters were changed
+    if (cc->GetEncodingParams()->GetPlaintextRootOfUnity() != 0 &&
+        (added || !PackedEncoding::HasParams(cc->GetCyclotomicOrder(), cc->GetEncodingParams()))) {
+        PackedEncoding::SetParams(cc->GetCyclotomicOrder(), cc->GetEncodingParams());
     }
 
     return cc;
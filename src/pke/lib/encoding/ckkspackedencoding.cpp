@@ -190,12 +190,15 @@ bool CKKSPackedEncoding::Encode() {
         const std::shared_ptr<ILDCRTParams<BigInteger>> params           = this->encodedVectorDCRT.GetParams();
         const std::vector<std::shared_ptr<ILNativeParams>>& nativeParams = params->GetParams();
 
+        // the towers are independent, so each one is reduced straight into a fresh vector
+        // that is then moved into the plaintext without copying the previous tower
+#pragma omp parallel for
         for (size_t i = 0; i < nativeParams.size(); i++) {
             NativeVector nativeVec(ringDim, nativeParams[i]->GetModulus());
             FitToNativeVector(temp, Max128BitValue(), &nativeVec);
-            NativePoly element = this->GetElement<DCRTPoly>().GetElementAtIndex(i);
-            element.SetValues(nativeVec, Format::COEFFICIENT);  // output was in coefficient format
-            this->encodedVectorDCRT.SetElementAtIndex(i, element);
+            NativePoly element(nativeParams[i], Format::COEFFICIENT);
+            element.SetValues(std::move(nativeVec), Format::COEFFICIENT);  // output was in coefficient format
+            this->encodedVectorDCRT.SetElementAtIndex(i, std::move(element));
         }
 
         usint numTowers = nativeParams.size();
@@ -257,20 +260,15 @@ bool CKKSPackedEncoding::Encode() {
         // Compute approxFactor, a value to scale down by, in case the value exceeds a 64-bit integer.
         int32_t MAX_BITS_IN_WORD = LargeScalingFactorConstants::MAX_BITS_IN_WORD;
 
-        int32_t logc = 0;
+        // ceil(log2(.)) is monotonic, so the largest magnitude alone determines logc
+        double maxAbs = 0;
         for (size_t i = 0; i < slots; ++i) {
             inverse[i] *= powP;
-            if (inverse[i].real() != 0) {
-                int32_t logci = static_cast<int32_t>(ceil(log2(std::abs(inverse[i].real()))));
-                if (logc < logci)
-                    logc = logci;
-            }
-            if (inverse[i].imag() != 0) {
-                int32_t logci = static_cast<int32_t>(ceil(log2(std::abs(inverse[i].imag()))));
-                if (logc < logci)
-                    logc = logci;
-            }
+            maxAbs = std::max(maxAbs, std::max(std::abs(inverse[i].real()), std::abs(inverse[i].imag())));
         }
+        int32_t logc = 0;
+        if (maxAbs != 0)
+            logc = std::max(logc, static_cast<int32_t>(ceil(log2(maxAbs))));
         if (logc < 0) {
             OPENFHE_THROW(math_error, "Too small scaling factor");
         }
@@ -351,12 +349,15 @@ bool CKKSPackedEncoding::Encode() {
         const std::shared_ptr<ILDCRTParams<BigInteger>> params           = this->encodedVectorDCRT.GetParams();
         const std::vector<std::shared_ptr<ILNativeParams>>& nativeParams = params->GetParams();
 
+        // the towers are independent, so each one is reduced straight into a fresh vector
+        // that is then moved into the plaintext without copying the previous tower
+#pragma omp parallel for
         for (size_t i = 0; i < nativeParams.size(); i++) {
             NativeVector nativeVec(ringDim, nativeParams[i]->GetModulus());
             FitToNativeVector(temp, Max64BitValue(), &nativeVec);
-            NativePoly element = this->GetElement<DCRTPoly>().GetElementAtIndex(i);
-            element.SetValues(nativeVec, Format::COEFFICIENT);  // output was in coefficient format
-            this->encodedVectorDCRT.SetElementAtIndex(i, element);
+            NativePoly element(nativeParams[i], Format::COEFFICIENT);
+            element.SetValues(std::move(nativeVec), Format::COEFFICIENT);  // output was in coefficient format
+            this->encodedVectorDCRT.SetElementAtIndex(i, std::move(element));
         }
 
         usint numTowers = nativeParams.size();
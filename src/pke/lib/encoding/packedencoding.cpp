@@ -39,14 +39,7 @@
 
 namespace lbcrypto {
 
-// TODO (dsuponit): we should not have globals!
-std::map<ModulusM, NativeInteger> PackedEncoding::m_initRoot;
-std::map<ModulusM, NativeInteger> PackedEncoding::m_bigModulus;
-std::map<ModulusM, NativeInteger> PackedEncoding::m_bigRoot;
-
 std::map<usint, usint> PackedEncoding::m_automorphismGenerator;
-std::map<usint, std::vector<usint>> PackedEncoding::m_toCRTPerm;
-std::map<usint, std::vector<usint>> PackedEncoding::m_fromCRTPerm;
 
 bool PackedEncoding::Encode() {
     if (this->isEncoded)
@@ -221,99 +214,119 @@ bool PackedEncoding::Decode() {
 }
 
 void PackedEncoding::Destroy() {
-    m_initRoot.clear();
-    m_bigModulus.clear();
-    m_bigRoot.clear();
+#pragma omp critical
+    { m_automorphismGenerator.clear(); }
+}
 
-    m_automorphismGenerator.clear();
-    m_toCRTPerm.clear();
-    m_fromCRTPerm.clear();
+usint PackedEncoding::GetAutomorphismGenerator(usint m) {
+    usint generator = 0;
+#pragma omp critical
+    {
+        auto it = m_automorphismGenerator.find(m);
+        if (it != m_automorphismGenerator.end())
+            generator = it->second;
+    }
+    return generator;
 }
 
-void PackedEncoding::SetParams(usint m, EncodingParams params) {
-    NativeInteger modulusNI(params->GetPlaintextModulus());  // native int modulus
-    std::string exception_message;
-    bool hadEx = false;
+bool PackedEncoding::HasParams(usint m, EncodingParams params) {
+    auto tables = params->GetPackedEncodingTables();
+    return tables != nullptr && tables->m == m;
+}
 
+void PackedEncoding::SetParams(usint m, EncodingParams params) {
     // initialize the CRT coefficients if not initialized
-    try {
-        if (IsPowerOfTwo(m)) {
+    auto tables = MakeTables(m, *params);
+
+    // the derived values are stored in params, which resets its tables, so they are attached last
 #pragma omp critical
-            { SetParams_2n(m, params); }
+    {
+        params->SetPlaintextRootOfUnity(tables->initRoot);
+        if (!IsPowerOfTwo(m)) {
+            params->SetPlaintextBigModulus(tables->bigModulus);
+            params->SetPlaintextBigRootOfUnity(tables->bigRoot);
+            usint generator = tables->automorphismGenerator;
+            params->SetPlaintextGenerator(generator);
+            m_automorphismGenerator[m] = generator;
+        }
+    }
+    params->SetPackedEncodingTables(tables);
+}
+
+std::shared_ptr<const PackedEncodingTables> PackedEncoding::GetTables(usint m, const EncodingParams& params) {
+    auto tables = params->GetPackedEncodingTables();
+    if (tables == nullptr || tables->m != m) {
+        // concurrent callers may both build the tables; either result is the same and is kept
+        tables = MakeTables(m, *params);
+        params->SetPackedEncodingTables(tables);
+    }
+    return tables;
+}
+
+std::shared_ptr<const PackedEncodingTables> PackedEncoding::MakeTables(usint m, const EncodingParamsImpl& params) {
+    auto tables      = std::make_shared<PackedEncodingTables>();
+    tables->m        = m;
+    tables->modulus  = NativeInteger(params.GetPlaintextModulus());  // native int modulus
+    tables->initRoot = params.GetPlaintextRootOfUnity();
+
+    if (IsPowerOfTwo(m)) {
+        MakeTables_2n(*tables);
+        return tables;
+    }
+
+    const NativeInteger& modulusNI = tables->modulus;
+
+    // Arbitrary: Bluestein based CRT Arb. So we need the 2mth root of unity
+    if (tables->initRoot == 0)
+        tables->initRoot = RootOfUnity<NativeInteger>(2 * m, modulusNI);
+
+    // Find a compatible big-modulus and root of unity for CRTArb
+    if (params.GetPlaintextBigModulus() == 0) {
+        usint nttDim = pow(2, ceil(log2(2 * m - 1)));
+        if ((modulusNI.ConvertToInt() - 1) % nttDim == 0) {
+            tables->bigModulus = modulusNI;
         }
         else {
-#pragma omp critical
-            {
-                const ModulusM modulusM = {modulusNI, m};
-                // Arbitrary: Bluestein based CRT Arb. So we need the 2mth root of unity
-                if (params->GetPlaintextRootOfUnity() == 0) {
-                    NativeInteger initRoot = RootOfUnity<NativeInteger>(2 * m, modulusNI);
-                    m_initRoot[modulusM]   = initRoot;
-                    params->SetPlaintextRootOfUnity(m_initRoot[modulusM].ConvertToInt());
-                }
-                else {
-                    m_initRoot[modulusM] = params->GetPlaintextRootOfUnity();
-                }
-
-                // Find a compatible big-modulus and root of unity for CRTArb
-                if (params->GetPlaintextBigModulus() == 0) {
-                    usint nttDim = pow(2, ceil(log2(2 * m - 1)));
-                    if ((modulusNI.ConvertToInt() - 1) % nttDim == 0) {
-                        m_bigModulus[modulusM] = modulusNI;
-                    }
-                    else {
-                        usint bigModulusSize   = ceil(log2(2 * m - 1)) + 2 * modulusNI.GetMSB() + 1;
-                        m_bigModulus[modulusM] = FirstPrime<NativeInteger>(bigModulusSize, nttDim);
-                    }
-                    m_bigRoot[modulusM] = RootOfUnity<NativeInteger>(nttDim, m_bigModulus[modulusM]);
-                    params->SetPlaintextBigModulus(m_bigModulus[modulusM]);
-                    params->SetPlaintextBigRootOfUnity(m_bigRoot[modulusM]);
-                }
-                else {
-                    m_bigModulus[modulusM] = params->GetPlaintextBigModulus();
-                    m_bigRoot[modulusM]    = params->GetPlaintextBigRootOfUnity();
-                }
-
-                // Find a generator for the automorphism group
-                if (params->GetPlaintextGenerator() == 0) {
-                    NativeInteger M(m);  // Hackish typecast
-                    NativeInteger automorphismGenerator = FindGeneratorCyclic<NativeInteger>(M);
-                    m_automorphismGenerator[m]          = automorphismGenerator.ConvertToInt();
-                    params->SetPlaintextGenerator(m_automorphismGenerator[m]);
-                }
-                else {
-                    m_automorphismGenerator[m] = params->GetPlaintextGenerator();
-                }
-
-                // Create the permutations that interchange the automorphism and crt
-                // ordering
-                usint phim = GetTotient(m);
-                auto tList = GetTotientList(m);
-                auto tIdx  = std::vector<usint>(m, -1);
-                for (usint i = 0; i < phim; i++) {
-                    tIdx[tList[i]] = i;
-                }
-
-                m_toCRTPerm[m]   = std::vector<usint>(phim);
-                m_fromCRTPerm[m] = std::vector<usint>(phim);
-
-                usint curr_index = 1;
-                for (usint i = 0; i < phim; i++) {
-                    m_toCRTPerm[m][tIdx[curr_index]] = i;
-                    m_fromCRTPerm[m][i]              = tIdx[curr_index];
-
-                    curr_index = curr_index * m_automorphismGenerator[m] % m;
-                }
-            }
+            usint bigModulusSize = ceil(log2(2 * m - 1)) + 2 * modulusNI.GetMSB() + 1;
+            tables->bigModulus   = FirstPrime<NativeInteger>(bigModulusSize, nttDim);
         }
+        tables->bigRoot = RootOfUnity<NativeInteger>(nttDim, tables->bigModulus);
+    }
+    else {
+        tables->bigModulus = params.GetPlaintextBigModulus();
+        tables->bigRoot    = params.GetPlaintextBigRootOfUnity();
+    }
+
+    // Find a generator for the automorphism group
+    if (params.GetPlaintextGenerator() == 0) {
+        NativeInteger M(m);  // Hackish typecast
+        tables->automorphismGenerator = FindGeneratorCyclic<NativeInteger>(M).ConvertToInt();
+    }
+    else {
+        tables->automorphismGenerator = params.GetPlaintextGenerator();
     }
-    catch (std::exception& e) {
-        exception_message = e.what();
-        hadEx             = true;
+
+    // Create the permutations that interchange the automorphism and crt
+    // ordering
+    usint phim = GetTotient(m);
+    auto tList = GetTotientList(m);
+    auto tIdx  = std::vector<usint>(m, -1);
+    for (usint i = 0; i < phim; i++) {
+        tIdx[tList[i]] = i;
+    }
+
+    tables->toCRTPerm   = std::vector<usint>(phim);
+    tables->fromCRTPerm = std::vector<usint>(phim);
+
+    usint curr_index = 1;
+    for (usint i = 0; i < phim; i++) {
+        tables->toCRTPerm[tIdx[curr_index]] = i;
+        tables->fromCRTPerm[i]              = tIdx[curr_index];
+
+        curr_index = curr_index * tables->automorphismGenerator % m;
     }
 
-    if (hadEx)
-        OPENFHE_THROW(openfhe_error, exception_message);
+    return tables;
 }
 
 template <typename P>
@@ -323,12 +336,8 @@ void PackedEncoding::Pack(P* ring, const PlaintextModulus& modulus) const {
     usint m = ring->GetCyclotomicOrder();  // cyclotomic order
     NativeInteger modulusNI(modulus);      // native int modulus
 
-    const ModulusM modulusM = {modulusNI, m};
-
     // Do the precomputation if not initialized
-    if (this->m_initRoot[modulusM].GetMSB() == 0) {
-        SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-    }
+    const auto tables = GetTables(m, this->encodingParams);
 
     usint phim = ring->GetRingDimension();
 
@@ -343,37 +352,39 @@ void PackedEncoding::Pack(P* ring, const PlaintextModulus& modulus) const {
     OPENFHE_DEBUG(*ring);
     OPENFHE_DEBUG(slotValues);
 
+    const auto& toCRTPerm = tables->toCRTPerm;
+
     // Transform Eval to Coeff
     if (IsPowerOfTwo(m)) {
-        if (m_toCRTPerm[m].size() > 0) {
+        if (toCRTPerm.size() > 0) {
             // Permute to CRT Order
             NativeVector permutedSlots(phim, modulusNI);
 
             for (usint i = 0; i < phim; i++) {
-                permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+                permutedSlots[i] = slotValues[toCRTPerm[i]];
             }
-            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(
-                permutedSlots, m_initRoot[modulusM], m, &slotValues);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(permutedSlots,
+                                                                                        tables->initRoot, m, &slotValues);
         }
         else {
-            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(
-                slotValues, m_initRoot[modulusM], m, &slotValues);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(slotValues, tables->initRoot,
+                                                                                        m, &slotValues);
         }
     }
     else {  // Arbitrary cyclotomic
         // Permute to CRT Order
         NativeVector permutedSlots(phim, modulusNI);
         for (usint i = 0; i < phim; i++) {
-            permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+            permutedSlots[i] = slotValues[toCRTPerm[i]];
         }
 
         OPENFHE_DEBUG("permutedSlots " << permutedSlots);
-        OPENFHE_DEBUG("m_initRoot[modulusM] " << m_initRoot[modulusM]);
-        OPENFHE_DEBUG("m_bigModulus[modulusM] " << m_bigModulus[modulusM]);
-        OPENFHE_DEBUG("m_bigRoot[modulusM] " << m_bigRoot[modulusM]);
+        OPENFHE_DEBUG("initRoot " << tables->initRoot);
+        OPENFHE_DEBUG("bigModulus " << tables->bigModulus);
+        OPENFHE_DEBUG("bigRoot " << tables->bigRoot);
 
         slotValues = ChineseRemainderTransformArb<NativeVector>().InverseTransform(
-            permutedSlots, m_initRoot[modulusM], m_bigModulus[modulusM], m_bigRoot[modulusM], m);
+            permutedSlots, tables->initRoot, tables->bigModulus, tables->bigRoot, m);
     }
 
     OPENFHE_DEBUG("slotvalues now " << slotValues);
@@ -394,12 +405,8 @@ void PackedEncoding::Unpack(P* ring, const PlaintextModulus& modulus) const {
     usint m = ring->GetCyclotomicOrder();  // cyclotomic order
     NativeInteger modulusNI(modulus);      // native int modulus
 
-    const ModulusM modulusM = {modulusNI, m};
-
     // Do the precomputation if not initialized
-    if (this->m_initRoot[modulusM].GetMSB() == 0) {
-        SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-    }
+    const auto tables = GetTables(m, this->encodingParams);
 
     usint phim = ring->GetRingDimension();  // ring dimension
 
@@ -416,18 +423,19 @@ void PackedEncoding::Unpack(P* ring, const PlaintextModulus& modulus) const {
     // Transform Coeff to Eval
     NativeVector permutedSlots(phim, modulusNI);
     if (IsPowerOfTwo(m)) {
-        ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(packedVector, m_initRoot[modulusM], m,
+        ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(packedVector, tables->initRoot, m,
                                                                                   &permutedSlots);
     }
     else {  // Arbitrary cyclotomic
         permutedSlots = ChineseRemainderTransformArb<NativeVector>().ForwardTransform(
-            packedVector, m_initRoot[modulusM], m_bigModulus[modulusM], m_bigRoot[modulusM], m);
+            packedVector, tables->initRoot, tables->bigModulus, tables->bigRoot, m);
     }
 
-    if (m_fromCRTPerm[m].size() > 0) {
+    const auto& fromCRTPerm = tables->fromCRTPerm;
+    if (fromCRTPerm.size() > 0) {
         // Permute to automorphism Order
         for (usint i = 0; i < phim; i++) {
-            packedVector[i] = permutedSlots[m_fromCRTPerm[m][i]];
+            packedVector[i] = permutedSlots[fromCRTPerm[i]];
         }
     }
     else {
@@ -445,58 +453,17 @@ void PackedEncoding::Unpack(P* ring, const PlaintextModulus& modulus) const {
     ring->SetValues(std::move(packedVectorRing), Format::COEFFICIENT);
 }
 
-void PackedEncoding::SetParams_2n(usint m, const NativeInteger& modulusNI) {
-    if (!MillerRabinPrimalityTest(modulusNI)) {
-        OPENFHE_THROW(math_error, "The modulus value is [" + modulusNI.ToString() + "]. It must be prime.");
-    }
-
-    const ModulusM modulusM = {modulusNI, m};
-
-    // Power of two: m/2-point FTT. So we need the mth root of unity
-    m_initRoot[modulusM] = RootOfUnity<NativeInteger>(m, modulusNI);
-
-    // Create the permutations that interchange the automorphism and crt ordering
-    // First we create the cyclic group generated by 5 and then adjoin the
-    // co-factor by multiplying by (-1)
-
-    usint phim      = (m >> 1);
-    usint phim_by_2 = (m >> 2);
-
-    m_toCRTPerm[m]   = std::vector<usint>(phim);
-    m_fromCRTPerm[m] = std::vector<usint>(phim);
-
-    usint curr_index = 1;
-    usint logn       = std::round(log2(m / 2));
-    for (usint i = 0; i < phim_by_2; i++) {
-        m_toCRTPerm[m][ReverseBits((curr_index - 1) / 2, logn)] = i;
-        m_fromCRTPerm[m][i]                                     = ReverseBits((curr_index - 1) / 2, logn);
-
-        usint cofactor_index = curr_index * (m - 1) % m;
-
-        m_toCRTPerm[m][ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
-        m_fromCRTPerm[m][i + phim_by_2]                             = ReverseBits((cofactor_index - 1) / 2, logn);
-
-        curr_index = curr_index * 5 % m;
-    }
-}
-
-void PackedEncoding::SetParams_2n(usint m, EncodingParams params) {
-    NativeInteger modulusNI(params->GetPlaintextModulus());  // native int modulus
+void PackedEncoding::MakeTables_2n(PackedEncodingTables& tables) {
+    const usint m                  = tables.m;
+    const NativeInteger& modulusNI = tables.modulus;
 
     if (!MillerRabinPrimalityTest(modulusNI)) {
         OPENFHE_THROW(math_error, "The modulus value is [" + modulusNI.ToString() + "]. It must be prime.");
     }
 
-    const ModulusM modulusM = {modulusNI, m};
-
     // Power of two: m/2-point FTT. So we need the mth root of unity
-    if (params->GetPlaintextRootOfUnity() == 0) {
-        m_initRoot[modulusM] = RootOfUnity<NativeInteger>(m, modulusNI);
-        params->SetPlaintextRootOfUnity(m_initRoot[modulusM]);
-    }
-    else {
-        m_initRoot[modulusM] = params->GetPlaintextRootOfUnity();
-    }
+    if (tables.initRoot == 0)
+        tables.initRoot = RootOfUnity<NativeInteger>(m, modulusNI);
 
     // Create the permutations that interchange the automorphism and crt ordering
     // First we create the cyclic group generated by 5 and then adjoin the
@@ -504,19 +471,19 @@ void PackedEncoding::SetParams_2n(usint m, EncodingParams params) {
     usint phim      = (m >> 1);
     usint phim_by_2 = (m >> 2);
 
-    m_toCRTPerm[m]   = std::vector<usint>(phim);
-    m_fromCRTPerm[m] = std::vector<usint>(phim);
+    tables.toCRTPerm   = std::vector<usint>(phim);
+    tables.fromCRTPerm = std::vector<usint>(phim);
 
     usint curr_index = 1;
     usint logn       = std::round(log2(m >> 1));
     for (usint i = 0; i < phim_by_2; i++) {
-        m_toCRTPerm[m][ReverseBits((curr_index - 1) / 2, logn)] = i;
-        m_fromCRTPerm[m][i]                                     = ReverseBits((curr_index - 1) / 2, logn);
+        tables.toCRTPerm[ReverseBits((curr_index - 1) / 2, logn)] = i;
+        tables.fromCRTPerm[i]                                     = ReverseBits((curr_index - 1) / 2, logn);
 
         usint cofactor_index = curr_index * (m - 1) % m;
 
-        m_toCRTPerm[m][ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
-        m_fromCRTPerm[m][i + phim_by_2]                             = ReverseBits((cofactor_index - 1) / 2, logn);
+        tables.toCRTPerm[ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
+        tables.fromCRTPerm[i + phim_by_2]                             = ReverseBits((cofactor_index - 1) / 2, logn);
 
         curr_index = curr_index * 5 % m;
     }
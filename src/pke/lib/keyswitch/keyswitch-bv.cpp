@@ -45,6 +45,7 @@
 #include "key/evalkeyrelin.h"
 #include "schemerns/rns-cryptoparameters.h"
 #include "cryptocontext.h"
+#include "utils/opcounters.h"
 
 namespace lbcrypto {
 
@@ -316,6 +317,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalKeySwitchPrecomputeCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    OpCounterScope opCount(OPCOUNT_KEYSWITCH);
     std::vector<DCRTPoly> bv(evalKey->GetBVector());
     std::vector<DCRTPoly> av(evalKey->GetAVector());
 
@@ -42,9 +42,16 @@
 #include "key/evalkeyrelin.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
+#include "utils/opcounters.h"
+#include "utils/utilities-int.h"
+
+#include <algorithm>
 
 namespace lbcrypto {
 
+// number of coefficients of one tower handled by a task of the key switching inner product
+const usint KEYSWITCH_BLOCK_SIZE = 1024;
+
 EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGen(const PrivateKey<DCRTPoly> oldKey,
                                                 const PrivateKey<DCRTPoly> newKey) const {
     return KeySwitchHYBRID::KeySwitchGen(oldKey, newKey, nullptr);
@@ -88,7 +95,20 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGen(const PrivateKey<DCRTPoly> oldKe
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
+
+    // the uniform vector a is expanded from a seed, so that serialized keys only carry b;
+    // threshold HE reuses a and its seed from the previous key
+    PRNGSeed seed{};
+    bool seeded = (ekPrev == nullptr);
+    if (seeded) {
+        seed = PseudoRandomNumberGenerator::GenerateSeed();
+    }
+    else {
+        const auto ekPrevRelin = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(ekPrev);
+        seeded                 = (ekPrevRelin != nullptr && ekPrevRelin->HasASeed());
+        if (seeded)
+            seed = ekPrevRelin->GetASeed();
+    }
 
     size_t numPartQ = cryptoParams->GetNumPartQ();
 
@@ -99,8 +119,8 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGen(const PrivateKey<DCRTPoly> oldKe
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                         ekPrev->GetAVector()[part];                      // threshold HE
+        DCRTPoly a = (ekPrev == nullptr) ? EvalKeyRelinImpl<DCRTPoly>::ExpandAVector(seed, part, paramsQP) :
+                                         ekPrev->GetAVector()[part];
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -129,6 +149,8 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGen(const PrivateKey<DCRTPoly> oldKe
 
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
+    if (seeded)
+        ek->SetASeed(seed);
 
     return ek;
 }
@@ -253,21 +275,33 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> cip
     return result;
 }
 
-Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ciphertext) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+// Returns the ModDown target {Q_l} of a ciphertext in the extended basis {Q_l, P}: the precomputed
+// basis when the towers of Q_l are a prefix of Q, otherwise one built from the ciphertext towers
+static std::shared_ptr<DCRTPoly::Params> GetParamsKeySwitchDown(
+    const std::shared_ptr<DCRTPoly::Params> paramsQlP, const std::shared_ptr<CryptoParametersRNS> cryptoParams) {
+    usint sizeQl = paramsQlP->GetParams().size() - cryptoParams->GetParamsP()->GetParams().size();
 
-    const auto paramsP   = cryptoParams->GetParamsP();
-    const auto paramsQlP = ciphertext->GetElements()[0].GetParams();
+    // the precomputed basis applies to ciphertexts whose towers are a prefix of Q
+    const auto& paramsQl = cryptoParams->GetParamsQlKS(sizeQl - 1);
+    bool prefix          = true;
+    for (usint i = 0; i < sizeQl && prefix; i++)
+        prefix = paramsQlP->GetParams()[i]->GetModulus() == paramsQl->GetParams()[i]->GetModulus();
+    if (prefix)
+        return paramsQl;
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
     std::vector<NativeInteger> moduliQ(sizeQl);
     std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
+    for (usint i = 0; i < sizeQl; i++) {
         moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
         rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
     }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+    return std::make_shared<DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+}
+
+Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ciphertext) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    auto paramsQl = GetParamsKeySwitchDown(ciphertext->GetElements()[0].GetParams(), cryptoParams);
 
     auto cTilda = ciphertext->GetElements();
 
@@ -295,18 +329,7 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
 
     const std::vector<DCRTPoly>& cTilda = ciphertext->GetElements();
 
-    const auto paramsP   = cryptoParams->GetParamsP();
-    const auto paramsQlP = cTilda[0].GetParams();
-
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
-    }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+    auto paramsQl = GetParamsKeySwitchDown(cTilda[0].GetParams(), cryptoParams);
 
     PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
 
@@ -331,82 +354,68 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     DCRTPoly c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParamsBase);
 
-    const std::shared_ptr<ParmType> paramsQl  = c.GetParams();
-    const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
-    const std::shared_ptr<ParmType> paramsQlP = c.GetExtendedCRTBasis(paramsP);
+    const std::shared_ptr<ParmType> paramsQl = c.GetParams();
+    const std::shared_ptr<ParmType> paramsP  = cryptoParams->GetParamsP();
 
     size_t sizeQl  = paramsQl->GetParams().size();
     size_t sizeP   = paramsP->GetParams().size();
     size_t sizeQlP = sizeQl + sizeP;
 
+    // the precomputed extended basis applies to ciphertexts whose towers are a prefix of Q
+    std::shared_ptr<ParmType> paramsQlP = cryptoParams->GetParamsQlP(sizeQl - 1);
+    for (size_t i = 0; i < sizeQl; i++) {
+        if (paramsQl->GetParams()[i]->GetModulus() != paramsQlP->GetParams()[i]->GetModulus()) {
+            paramsQlP = c.GetExtendedCRTBasis(paramsP);
+            break;
+        }
+    }
+
     uint32_t alpha = cryptoParams->GetNumPerPartQ();
     // The number of digits of the current ciphertext
     uint32_t numPartQl = ceil((static_cast<double>(sizeQl)) / alpha);
     if (numPartQl > cryptoParams->GetNumberOfQPartitions())
         numPartQl = cryptoParams->GetNumberOfQPartitions();
 
-    std::vector<DCRTPoly> partsCt(numPartQl);
+    std::vector<DCRTPoly> partsCtExt(numPartQl);
 
-    // Digit decomposition
-    // Zero-padding and split
+    // Digit decomposition: every tower of c is copied once for the ModUp of its digit and
+    // then moved (c is a copy) into the extended digit. The digits are independent, so the
+    // loop runs in parallel when there are enough of them to keep all threads busy;
+    // otherwise the parallelism inside ApproxSwitchCRTBasis and the NTTs is used.
+    bool parallelDigits = numPartQl > 1 && numPartQl >= static_cast<uint32_t>(OpenFHEParallelControls.GetMachineThreads());
+#pragma omp parallel for if (parallelDigits)
     for (uint32_t part = 0; part < numPartQl; part++) {
-        if (part == numPartQl - 1) {
-            auto paramsPartQ = cryptoParams->GetParamsPartQ(part);
+        const auto& paramsPartQl =
+            (part == numPartQl - 1) ? cryptoParams->GetParamsPartQl(sizeQl - 1) : cryptoParams->GetParamsPartQ(part);
 
-            uint32_t sizePartQl = sizeQl - alpha * part;
-
-            std::vector<NativeInteger> moduli(sizePartQl);
-            std::vector<NativeInteger> roots(sizePartQl);
-
-            for (uint32_t i = 0; i < sizePartQl; i++) {
-                moduli[i] = paramsPartQ->GetParams()[i]->GetModulus();
-                roots[i]  = paramsPartQ->GetParams()[i]->GetRootOfUnity();
-            }
+        uint32_t sizePartQl = paramsPartQl->GetParams().size();
+        usint startPartIdx  = alpha * part;
+        usint endPartIdx    = startPartIdx + sizePartQl;
 
-            auto params = DCRTPoly::Params(paramsPartQ->GetCyclotomicOrder(), moduli, roots, {}, {}, 0);
-
-            partsCt[part] = DCRTPoly(std::make_shared<ParmType>(params), Format::EVALUATION, true);
-        }
-        else {
-            partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQ(part), Format::EVALUATION, true);
-        }
-
-        usint sizePartQl   = partsCt[part].GetNumOfElements();
-        usint startPartIdx = alpha * part;
+        DCRTPoly partCt(paramsPartQl, Format::EVALUATION);
         for (uint32_t i = 0, idx = startPartIdx; i < sizePartQl; i++, idx++) {
-            partsCt[part].SetElementAtIndex(i, c.GetElementAtIndex(idx));
+            partCt.SetElementAtIndex(i, c.GetElementAtIndex(idx));
         }
-    }
+        partCt.SetFormat(Format::COEFFICIENT);
 
-    std::vector<DCRTPoly> partsCtCompl(numPartQl);
-    std::vector<DCRTPoly> partsCtExt(numPartQl);
+        DCRTPoly partCtCompl = partCt.ApproxSwitchCRTBasis(
+            cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
+            cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
+            cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
 
-    for (uint32_t part = 0; part < numPartQl; part++) {
-        auto partCtClone = partsCt[part].Clone();
-        partCtClone.SetFormat(Format::COEFFICIENT);
-
-        uint32_t sizePartQl = partsCt[part].GetNumOfElements();
-        partsCtCompl[part]  = partCtClone.ApproxSwitchCRTBasis(
-             cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
-             cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
-             cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
-
-        partsCtCompl[part].SetFormat(Format::EVALUATION);
+        partCtCompl.SetFormat(Format::EVALUATION);
 
-        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
-
-        usint startPartIdx = alpha * part;
-        usint endPartIdx   = startPartIdx + sizePartQl;
+        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION);
         for (usint i = 0; i < startPartIdx; i++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i));
+            partsCtExt[part].SetElementAtIndex(i, std::move(partCtCompl.ElementAtIndex(i)));
         }
-        for (usint i = startPartIdx, idx = 0; i < endPartIdx; i++, idx++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCt[part].GetElementAtIndex(idx));
+        for (usint i = startPartIdx; i < endPartIdx; i++) {
+            partsCtExt[part].SetElementAtIndex(i, std::move(c.ElementAtIndex(i)));
         }
         for (usint i = endPartIdx; i < sizeQlP; ++i) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i - sizePartQl));
+            partsCtExt[part].SetElementAtIndex(i, std::move(partCtCompl.ElementAtIndex(i - sizePartQl)));
         }
     }
 
@@ -440,6 +449,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    OpCounterScope opCount(OPCOUNT_KEYSWITCH);
     const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
     const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
     const std::vector<DCRTPoly>& av = evalKey->GetAVector();
@@ -451,32 +461,79 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     size_t sizeQlP = paramsQlP->GetParams().size();
     size_t sizeQ   = cryptoParams->GetElementParams()->GetParams().size();
 
-    DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
-    DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
-
-    for (uint32_t j = 0; j < digits->size(); j++) {
-        const DCRTPoly& cj = (*digits)[j];
-        const DCRTPoly& bj = bv[j];
-        const DCRTPoly& aj = av[j];
-
-        for (usint i = 0; i < sizeQl; i++) {
-            const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(i);
-            const auto& bji = bj.GetElementAtIndex(i);
-
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
+    const uint32_t numDigits = digits->size();
+    const usint ringDim      = paramsQlP->GetRingDimension();
+
+    // tower i of Ql*P uses tower i of the key for i < sizeQl and tower sizeQ + (i - sizeQl) otherwise;
+    // the value vectors are looked up once here rather than per coefficient
+    std::vector<const NativeVector*> cVals(sizeQlP * numDigits);
+    std::vector<const NativeVector*> bVals(sizeQlP * numDigits);
+    std::vector<const NativeVector*> aVals(sizeQlP * numDigits);
+    std::vector<NativeVector> sum0(sizeQlP);
+    std::vector<NativeVector> sum1(sizeQlP);
+    for (usint i = 0; i < sizeQlP; i++) {
+        usint idx = (i < sizeQl) ? i : sizeQ + (i - sizeQl);
+        for (uint32_t j = 0; j < numDigits; j++) {
+            cVals[i * numDigits + j] = &(*digits)[j].GetElementAtIndex(i).GetValues();
+            bVals[i * numDigits + j] = &bv[j].GetElementAtIndex(idx).GetValues();
+            aVals[i * numDigits + j] = &av[j].GetElementAtIndex(idx).GetValues();
         }
-        for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-            const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(idx);
-            const auto& bji = bj.GetElementAtIndex(idx);
+        sum0[i] = NativeVector(ringDim, paramsQlP->GetParams()[i]->GetModulus());
+        sum1[i] = NativeVector(ringDim, paramsQlP->GetParams()[i]->GetModulus());
+    }
 
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
+    // inner product over all digits, computed per (tower, coefficient block) with a single
+    // modular reduction per coefficient
+    const usint numBlocks = (ringDim + KEYSWITCH_BLOCK_SIZE - 1) / KEYSWITCH_BLOCK_SIZE;
+#pragma omp parallel for collapse(2)
+    for (usint i = 0; i < sizeQlP; i++) {
+        for (usint blk = 0; blk < numBlocks; blk++) {
+            const NativeVector* const* c = &cVals[i * numDigits];
+            const NativeVector* const* b = &bVals[i * numDigits];
+            const NativeVector* const* a = &aVals[i * numDigits];
+            const NativeInteger& qi      = paramsQlP->GetParams()[i]->GetModulus();
+            const usint start            = blk * KEYSWITCH_BLOCK_SIZE;
+            const usint end              = std::min(ringDim, start + KEYSWITCH_BLOCK_SIZE);
+#if defined(HAVE_INT128) && NATIVEINT == 64
+            // the products are below 2^120 for moduli of at most 60 bits, so up to 256 digits
+            // can be accumulated without overflow
+            const uint64_t q         = qi.ConvertToInt();
+            const DoubleNativeInt mu = ~DoubleNativeInt(0) / q;
+            for (usint r = start; r < end; r++) {
+                DoubleNativeInt acc0 = 0;
+                DoubleNativeInt acc1 = 0;
+                for (uint32_t j = 0; j < numDigits; j++) {
+                    uint64_t cjr = (*c[j])[r].ConvertToInt();
+                    acc0 += Mul128(cjr, (*b[j])[r].ConvertToInt());
+                    acc1 += Mul128(cjr, (*a[j])[r].ConvertToInt());
+                }
+                sum0[i][r] = BarrettUint128ModUint64(acc0, q, mu);
+                sum1[i][r] = BarrettUint128ModUint64(acc1, q, mu);
+            }
+#else
+            const NativeInteger mu = qi.ComputeMu();
+            for (usint r = start; r < end; r++) {
+                NativeInteger acc0(0);
+                NativeInteger acc1(0);
+                for (uint32_t j = 0; j < numDigits; j++) {
+                    const NativeInteger& cjr = (*c[j])[r];
+                    acc0.ModAddFastEq(cjr.ModMul((*b[j])[r], qi, mu), qi);
+                    acc1.ModAddFastEq(cjr.ModMul((*a[j])[r], qi, mu), qi);
+                }
+                sum0[i][r] = acc0;
+                sum1[i][r] = acc1;
+            }
+#endif
         }
     }
 
+    DCRTPoly cTilda0(paramsQlP, Format::EVALUATION);
+    DCRTPoly cTilda1(paramsQlP, Format::EVALUATION);
+    for (usint i = 0; i < sizeQlP; i++) {
+        cTilda0.ElementAtIndex(i).SetValues(std::move(sum0[i]), Format::EVALUATION);
+        cTilda1.ElementAtIndex(i).SetValues(std::move(sum1[i]), Format::EVALUATION);
+    }
+
     return std::make_shared<std::vector<DCRTPoly>>(
         std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
 }
@@ -0,0 +1,217 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "lineartransform.h"
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace lbcrypto {
+
+namespace {
+
+bool IsPowerOfTwo(uint32_t x) {
+    return x != 0 && (x & (x - 1)) == 0;
+}
+
+}  // namespace
+
+LinearTransformPrecom::LinearTransformPrecom(uint32_t dim, uint32_t slots,
+                                             std::map<uint32_t, std::vector<double>> diagonals, uint32_t bStep)
+    : m_dim(dim), m_slots(slots), m_bStep(bStep) {
+    if (!IsPowerOfTwo(dim) || !IsPowerOfTwo(slots) || dim > slots)
+        OPENFHE_THROW(config_error, "The matrix dimension " + std::to_string(dim) +
+                                        " must be a power of two not larger than the number of slots " +
+                                        std::to_string(slots));
+    if (bStep > dim)
+        OPENFHE_THROW(config_error, "The baby step cannot be larger than the matrix dimension");
+
+    for (auto& diag : diagonals) {
+        if (diag.first >= dim || diag.second.size() != dim)
+            OPENFHE_THROW(config_error, "Diagonal " + std::to_string(diag.first) + " does not match dimension " +
+                                            std::to_string(dim));
+        if (std::any_of(diag.second.begin(), diag.second.end(), [](double v) { return v != 0; })) {
+            m_indices.push_back(diag.first);
+            m_diagonals.push_back(std::move(diag.second));
+        }
+    }
+
+    // the cost of a split is the number of distinct nonzero baby and giant rotations;
+    // ties go to the larger baby step as baby-step rotations are hoisted
+    auto countSteps = [this](uint32_t g, std::vector<int32_t>* babySteps, std::vector<int32_t>* giantSteps) {
+        std::set<int32_t> babies, giants;
+        for (auto k : m_indices) {
+            babies.insert(k % g);
+            giants.insert(g * (k / g));
+        }
+        if (babySteps != nullptr) {
+            babySteps->assign(babies.begin(), babies.end());
+            giantSteps->assign(giants.begin(), giants.end());
+        }
+        return babies.size() - babies.count(0) + giants.size() - giants.count(0);
+    };
+
+    if (m_bStep == 0) {
+        m_bStep     = 1;
+        size_t best = countSteps(1, nullptr, nullptr);
+        for (uint32_t g = 2; g <= dim; g <<= 1) {
+            size_t cost = countSteps(g, nullptr, nullptr);
+            if (cost <= best) {
+                best    = cost;
+                m_bStep = g;
+            }
+        }
+    }
+    countSteps(m_bStep, &m_babySteps, &m_giantSteps);
+}
+
+std::shared_ptr<LinearTransformPrecom> LinearTransformPrecom::FromMatrix(const std::vector<std::vector<double>>& A,
+                                                                         uint32_t slots, uint32_t bStep) {
+    if (A.empty() || A[0].empty())
+        OPENFHE_THROW(config_error, "The matrix is empty");
+
+    uint32_t rows = A.size();
+    uint32_t cols = A[0].size();
+    for (const auto& row : A) {
+        if (row.size() != cols)
+            OPENFHE_THROW(config_error, "All rows of the matrix must have the same length");
+    }
+
+    uint32_t dim = 1;
+    while (dim < std::max(rows, cols))
+        dim <<= 1;
+
+    std::map<uint32_t, std::vector<double>> diagonals;
+    for (uint32_t k = 0; k < dim; k++) {
+        std::vector<double> diag(dim);
+        for (uint32_t i = 0; i < rows; i++) {
+            uint32_t j = (i + k) & (dim - 1);
+            if (j < cols)
+                diag[i] = A[i][j];
+        }
+        diagonals.emplace(k, std::move(diag));
+    }
+
+    return std::make_shared<LinearTransformPrecom>(dim, slots, std::move(diagonals), bStep);
+}
+
+std::vector<double> LinearTransformPrecom::GetSlotVector(uint32_t pos) const {
+    uint32_t shift = m_bStep * (m_indices[pos] / m_bStep);
+
+    std::vector<double> result(m_slots);
+    const auto& diag = m_diagonals[pos];
+    for (uint32_t p = 0; p < m_dim; p++)
+        result[(p + shift) & (m_slots - 1)] = diag[p];
+    return result;
+}
+
+std::vector<int32_t> LinearTransformPrecom::GetReplicationSteps() const {
+    std::vector<int32_t> steps;
+    for (uint32_t t = m_dim; t < m_slots; t <<= 1)
+        steps.push_back(-static_cast<int32_t>(t));
+    return steps;
+}
+
+std::vector<int32_t> LinearTransformPrecom::GetRotationIndices() const {
+    std::set<int32_t> indices(m_babySteps.begin(), m_babySteps.end());
+    indices.insert(m_giantSteps.begin(), m_giantSteps.end());
+    for (auto step : GetReplicationSteps())
+        indices.insert(step);
+    indices.erase(0);
+    return std::vector<int32_t>(indices.begin(), indices.end());
+}
+
+std::vector<ConstPlaintext> LinearTransformPrecom::GetEncodedDiagonals(uint32_t level) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto it = m_encoded.find(level);
+    return (it != m_encoded.end()) ? it->second : std::vector<ConstPlaintext>();
+}
+
+void LinearTransformPrecom::SetEncodedDiagonals(uint32_t level, std::vector<ConstPlaintext> encoded) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_encoded[level] = std::move(encoded);
+}
+
+void LinearTransformPrecom::ClearCache() const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_encoded.clear();
+}
+
+MatMulPrecom::MatMulPrecom(uint32_t d, uint32_t slots) : m_d(d) {
+    uint32_t dim = d * d;
+    if (!IsPowerOfTwo(d) || dim > slots)
+        OPENFHE_THROW(config_error, "The matrix dimension " + std::to_string(d) +
+                                        " must be a power of two with d * d not larger than the number of slots");
+
+    // builds the transform that moves slot source(i, j) to slot i * d + j
+    auto permutation = [d, dim, slots](const std::function<uint32_t(uint32_t, uint32_t)>& source) {
+        std::map<uint32_t, std::vector<double>> diagonals;
+        for (uint32_t i = 0; i < d; i++) {
+            for (uint32_t j = 0; j < d; j++) {
+                uint32_t p = i * d + j;
+                uint32_t k = (source(i, j) + dim - p) % dim;
+                auto it    = diagonals.find(k);
+                if (it == diagonals.end())
+                    it = diagonals.emplace(k, std::vector<double>(dim)).first;
+                it->second[p] = 1;
+            }
+        }
+        return std::make_shared<LinearTransformPrecom>(dim, slots, std::move(diagonals));
+    };
+
+    m_sigma = permutation([d](uint32_t i, uint32_t j) { return i * d + (i + j) % d; });
+    m_tau   = permutation([d](uint32_t i, uint32_t j) { return ((i + j) % d) * d + j; });
+    for (uint32_t k = 1; k < d; k++) {
+        m_phi.push_back(permutation([d, k](uint32_t i, uint32_t j) { return i * d + (j + k) % d; }));
+        m_psi.push_back(permutation([d, k](uint32_t i, uint32_t j) { return ((i + k) % d) * d + j; }));
+    }
+}
+
+std::vector<int32_t> MatMulPrecom::GetRotationIndices() const {
+    std::set<int32_t> indices;
+    auto add = [&indices](const std::shared_ptr<LinearTransformPrecom>& lt) {
+        auto ltIndices = lt->GetRotationIndices();
+        indices.insert(ltIndices.begin(), ltIndices.end());
+    };
+    add(m_sigma);
+    add(m_tau);
+    for (const auto& lt : m_phi)
+        add(lt);
+    for (const auto& lt : m_psi)
+        add(lt);
+    return std::vector<int32_t>(indices.begin(), indices.end());
+}
+
+}  // namespace lbcrypto
@@ -42,6 +42,9 @@ BFV implementation. See https://eprint.iacr.org/2021/204 for details.
 #include "cryptocontext.h"
 #include "ciphertext.h"
 
+#include <algorithm>
+#include <memory>
+
 namespace lbcrypto {
 
 void LeveledSHEBFVRNS::EvalAddInPlace(Ciphertext<DCRTPoly>& ciphertext, ConstPlaintext plaintext) const {
@@ -177,62 +180,32 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalMult(ConstCiphertext<DCRTPoly> cipher
     const auto cryptoParams =
         std::dynamic_pointer_cast<CryptoParametersBFVRNS>(ciphertext1->GetCryptoContext()->GetCryptoParameters());
 
-    std::vector<DCRTPoly> cv1 = ciphertext1->GetElements();
-    std::vector<DCRTPoly> cv2 = ciphertext2->GetElements();
+    const std::vector<DCRTPoly>& cv1 = ciphertext1->GetElements();
+    const std::vector<DCRTPoly>& cv2 = ciphertext2->GetElements();
 
     size_t cv1Size    = cv1.size();
     size_t cv2Size    = cv2.size();
+    size_t cvExtSize  = cv1Size + cv2Size;
     size_t cvMultSize = cv1Size + cv2Size - 1;
     size_t sizeQ      = cv1[0].GetNumOfElements();
 
+    MultiplicationTechnique technique = cryptoParams->GetMultiplicationTechnique();
+
     // l is index correspinding to leveled parameters in cryptoParameters precomputations in HPSPOVERQLEVELED
     size_t l = 0;
 
-    std::vector<DCRTPoly> cvMult(cvMultSize);
-
-    if (cryptoParams->GetMultiplicationTechnique() == HPS) {
-        for (size_t i = 0; i < cv1Size; i++) {
-            cv1[i].ExpandCRTBasis(cryptoParams->GetParamsQlRl(), cryptoParams->GetParamsRl(),
-                                  cryptoParams->GetQlHatInvModq(), cryptoParams->GetQlHatInvModqPrecon(),
-                                  cryptoParams->GetQlHatModr(), cryptoParams->GetalphaQlModr(),
-                                  cryptoParams->GetModrBarrettMu(), cryptoParams->GetqInv(), Format::EVALUATION);
-        }
-
-        for (size_t i = 0; i < cv2Size; i++) {
-            cv2[i].ExpandCRTBasis(cryptoParams->GetParamsQlRl(), cryptoParams->GetParamsRl(),
-                                  cryptoParams->GetQlHatInvModq(), cryptoParams->GetQlHatInvModqPrecon(),
-                                  cryptoParams->GetQlHatModr(), cryptoParams->GetalphaQlModr(),
-                                  cryptoParams->GetModrBarrettMu(), cryptoParams->GetqInv(), Format::EVALUATION);
-        }
-    }
-    else if (cryptoParams->GetMultiplicationTechnique() == HPSPOVERQ) {
-        for (size_t i = 0; i < cv1Size; i++) {
-            // Expand ciphertext1 from basis Q to PQ.
-            cv1[i].ExpandCRTBasis(cryptoParams->GetParamsQlRl(sizeQ - 1), cryptoParams->GetParamsRl(sizeQ - 1),
-                                  cryptoParams->GetQlHatInvModq(sizeQ - 1),
-                                  cryptoParams->GetQlHatInvModqPrecon(sizeQ - 1), cryptoParams->GetQlHatModr(sizeQ - 1),
-                                  cryptoParams->GetalphaQlModr(sizeQ - 1), cryptoParams->GetModrBarrettMu(),
-                                  cryptoParams->GetqInv(), Format::EVALUATION);
-        }
-
-        size_t sizeQ = cv2[0].GetNumOfElements();
-
-        DCRTPoly::CRTBasisExtensionPrecomputations basisPQ(
-            cryptoParams->GetParamsQlRl(sizeQ - 1), cryptoParams->GetParamsRl(sizeQ - 1),
-            cryptoParams->GetParamsQl(sizeQ - 1), cryptoParams->GetmNegRlQHatInvModq(sizeQ - 1),
-            cryptoParams->GetmNegRlQHatInvModqPrecon(sizeQ - 1), cryptoParams->GetqInvModr(),
-            cryptoParams->GetModrBarrettMu(), cryptoParams->GetRlHatInvModr(sizeQ - 1),
-            cryptoParams->GetRlHatInvModrPrecon(sizeQ - 1), cryptoParams->GetRlHatModq(sizeQ - 1),
-            cryptoParams->GetalphaRlModq(sizeQ - 1), cryptoParams->GetModqBarrettMu(), cryptoParams->GetrInv());
-
-        for (size_t i = 0; i < cv2Size; i++) {
-            cv2[i].SetFormat(Format::COEFFICIENT);
-            // Switch ciphertext2 from basis Q to P to PQ.
-            cv2[i].FastExpandCRTBasisPloverQ(basisPQ);
-            cv2[i].SetFormat(Format::EVALUATION);
-        }
-    }
-    else if (cryptoParams->GetMultiplicationTechnique() == HPSPOVERQLEVELED) {
+    std::unique_ptr<DCRTPoly::CRTBasisExtensionPrecomputations> basisPQ;
+    if (technique == HPSPOVERQ) {
+        size_t sizeQ2 = cv2[0].GetNumOfElements();
+        basisPQ       = std::make_unique<DCRTPoly::CRTBasisExtensionPrecomputations>(
+            cryptoParams->GetParamsQlRl(sizeQ2 - 1), cryptoParams->GetParamsRl(sizeQ2 - 1),
+            cryptoParams->GetParamsQl(sizeQ2 - 1), cryptoParams->GetmNegRlQHatInvModq(sizeQ2 - 1),
+            cryptoParams->GetmNegRlQHatInvModqPrecon(sizeQ2 - 1), cryptoParams->GetqInvModr(),
+            cryptoParams->GetModrBarrettMu(), cryptoParams->GetRlHatInvModr(sizeQ2 - 1),
+            cryptoParams->GetRlHatInvModrPrecon(sizeQ2 - 1), cryptoParams->GetRlHatModq(sizeQ2 - 1),
+            cryptoParams->GetalphaRlModq(sizeQ2 - 1), cryptoParams->GetModqBarrettMu(), cryptoParams->GetrInv());
+    }
+    else if (technique == HPSPOVERQLEVELED) {
         size_t c1depth = ciphertext1->GetNoiseScaleDeg();
         size_t c2depth = ciphertext2->GetNoiseScaleDeg();
 
@@ -243,50 +216,71 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalMult(ConstCiphertext<DCRTPoly> cipher
         uint32_t levelsDropped = FindLevelsToDrop(levels, cryptoParams, dcrtBits, false);
         l                      = levelsDropped > 0 ? sizeQ - 1 - levelsDropped : sizeQ - 1;
 
-        for (size_t i = 0; i < cv1Size; i++) {
-            cv1[i].SetFormat(Format::COEFFICIENT);
-            if (l < sizeQ - 1) {
-                // Drop from basis Q to Q_l.
-                cv1[i] =
-                    cv1[i].ScaleAndRound(cryptoParams->GetParamsQl(l), cryptoParams->GetQlQHatInvModqDivqModq(l),
-                                         cryptoParams->GetQlQHatInvModqDivqFrac(l), cryptoParams->GetModqBarrettMu());
-            }
-            // Expand ciphertext1 from basis Q_l to PQ_l.
-            cv1[i].ExpandCRTBasis(cryptoParams->GetParamsQlRl(l), cryptoParams->GetParamsRl(l),
-                                  cryptoParams->GetQlHatInvModq(l), cryptoParams->GetQlHatInvModqPrecon(l),
-                                  cryptoParams->GetQlHatModr(l), cryptoParams->GetalphaQlModr(l),
-                                  cryptoParams->GetModrBarrettMu(), cryptoParams->GetqInv(), Format::EVALUATION);
-        }
-
-        DCRTPoly::CRTBasisExtensionPrecomputations basisPQ(
+        basisPQ = std::make_unique<DCRTPoly::CRTBasisExtensionPrecomputations>(
             cryptoParams->GetParamsQlRl(l), cryptoParams->GetParamsRl(l), cryptoParams->GetParamsQl(l),
             cryptoParams->GetmNegRlQHatInvModq(l), cryptoParams->GetmNegRlQHatInvModqPrecon(l),
             cryptoParams->GetqInvModr(), cryptoParams->GetModrBarrettMu(), cryptoParams->GetRlHatInvModr(l),
             cryptoParams->GetRlHatInvModrPrecon(l), cryptoParams->GetRlHatModq(l), cryptoParams->GetalphaRlModq(l),
             cryptoParams->GetModqBarrettMu(), cryptoParams->GetrInv());
-
-        for (size_t i = 0; i < cv2Size; i++) {
-            cv2[i].SetFormat(Format::COEFFICIENT);
-            // Switch ciphertext2 from basis Q to P to PQ.
-            cv2[i].FastExpandCRTBasisPloverQ(basisPQ);
-            cv2[i].SetFormat(Format::EVALUATION);
-        }
     }
-    else {
-        for (size_t i = 0; i < cv1Size; i++) {
-            cv1[i].FastBaseConvqToBskMontgomery(
-                cryptoParams->GetParamsBsk(), cryptoParams->GetModuliQ(), cryptoParams->GetModuliBsk(),
-                cryptoParams->GetModbskBarrettMu(), cryptoParams->GetmtildeQHatInvModq(),
-                cryptoParams->GetmtildeQHatInvModqPrecon(), cryptoParams->GetQHatModbsk(),
-                cryptoParams->GetQHatModmtilde(), cryptoParams->GetQModbsk(), cryptoParams->GetQModbskPrecon(),
-                cryptoParams->GetNegQInvModmtilde(), cryptoParams->GetmtildeInvModbsk(),
-                cryptoParams->GetmtildeInvModbskPrecon());
 
-            cv1[i].SetFormat(Format::EVALUATION);
+    // The elements of both ciphertexts are copied once each, straight into the preallocated polynomials that
+    // are then extended. The elements are independent, so they are extended in parallel when there are enough of
+    // them to keep all threads busy; otherwise the parallelism inside the basis extensions is used.
+    std::vector<DCRTPoly> cv1Ext(cv1Size);
+    std::vector<DCRTPoly> cv2Ext(cv2Size);
+    bool parallelElements = cvExtSize >= static_cast<size_t>(OpenFHEParallelControls.GetMachineThreads());
+#pragma omp parallel for if (parallelElements)
+    for (size_t k = 0; k < cvExtSize; k++) {
+        bool first    = k < cv1Size;
+        DCRTPoly& ext = first ? cv1Ext[k] : cv2Ext[k - cv1Size];
+        ext           = first ? cv1[k] : cv2[k - cv1Size];
+
+        if (technique == HPS) {
+            ext.ExpandCRTBasis(cryptoParams->GetParamsQlRl(), cryptoParams->GetParamsRl(),
+                               cryptoParams->GetQlHatInvModq(), cryptoParams->GetQlHatInvModqPrecon(),
+                               cryptoParams->GetQlHatModr(), cryptoParams->GetalphaQlModr(),
+                               cryptoParams->GetModrBarrettMu(), cryptoParams->GetqInv(), Format::EVALUATION);
+        }
+        else if (technique == HPSPOVERQ) {
+            if (first) {
+                // Expand ciphertext1 from basis Q to PQ.
+                ext.ExpandCRTBasis(cryptoParams->GetParamsQlRl(sizeQ - 1), cryptoParams->GetParamsRl(sizeQ - 1),
+                                   cryptoParams->GetQlHatInvModq(sizeQ - 1),
+                                   cryptoParams->GetQlHatInvModqPrecon(sizeQ - 1),
+                                   cryptoParams->GetQlHatModr(sizeQ - 1), cryptoParams->GetalphaQlModr(sizeQ - 1),
+                                   cryptoParams->GetModrBarrettMu(), cryptoParams->GetqInv(), Format::EVALUATION);
+            }
+            else {
+                ext.SetFormat(Format::COEFFICIENT);
+                // Switch ciphertext2 from basis Q to P to PQ.
+                ext.FastExpandCRTBasisPloverQ(*basisPQ);
+                ext.SetFormat(Format::EVALUATION);
+            }
         }
-
-        for (size_t i = 0; i < cv2Size; i++) {
-            cv2[i].FastBaseConvqToBskMontgomery(
+        else if (technique == HPSPOVERQLEVELED) {
+            ext.SetFormat(Format::COEFFICIENT);
+            if (first) {
+                if (l < sizeQ - 1) {
+                    // Drop from basis Q to Q_l.
+                    ext = ext.ScaleAndRound(cryptoParams->GetParamsQl(l), cryptoParams->GetQlQHatInvModqDivqModq(l),
+                                            cryptoParams->GetQlQHatInvModqDivqFrac(l),
+                                            cryptoParams->GetModqBarrettMu());
+                }
+                // Expand ciphertext1 from basis Q_l to PQ_l.
+                ext.ExpandCRTBasis(cryptoParams->GetParamsQlRl(l), cryptoParams->GetParamsRl(l),
+                                   cryptoParams->GetQlHatInvModq(l), cryptoParams->GetQlHatInvModqPrecon(l),
+                                   cryptoParams->GetQlHatModr(l), cryptoParams->GetalphaQlModr(l),
+                                   cryptoParams->GetModrBarrettMu(), cryptoParams->GetqInv(), Format::EVALUATION);
+            }
+            else {
+                // Switch ciphertext2 from basis Q to P to PQ.
+                ext.FastExpandCRTBasisPloverQ(*basisPQ);
+                ext.SetFormat(Format::EVALUATION);
+            }
+        }
+        else {
+            ext.FastBaseConvqToBskMontgomery(
                 cryptoParams->GetParamsBsk(), cryptoParams->GetModuliQ(), cryptoParams->GetModuliBsk(),
                 cryptoParams->GetModbskBarrettMu(), cryptoParams->GetmtildeQHatInvModq(),
                 cryptoParams->GetmtildeQHatInvModqPrecon(), cryptoParams->GetQHatModbsk(),
@@ -294,110 +288,60 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalMult(ConstCiphertext<DCRTPoly> cipher
                 cryptoParams->GetNegQInvModmtilde(), cryptoParams->GetmtildeInvModbsk(),
                 cryptoParams->GetmtildeInvModbskPrecon());
 
-            cv2[i].SetFormat(Format::EVALUATION);
-        }
-    }
-
-#ifdef USE_KARATSUBA
-
-    if (cv1Size == 2 && cv2Size == 2) {
-        // size of each ciphertxt = 2, use Karatsuba
-        cvMult[0] = cv1[0] * cv2[0];  // a
-        cvMult[2] = cv1[1] * cv2[1];  // b
-
-        cvMult[1] = cv1[0] + cv1[1];
-        cvMult[1] *= (cv2[0] + cv2[1]);
-        cvMult[1] -= cvMult[2];
-        cvMult[1] -= cvMult[0];
-    }
-    else {  // if size of any of the ciphertexts > 2
-        std::vector<bool> isFirstAdd(cvMultSize, true);
-
-        for (size_t i = 0; i < cv1Size; i++) {
-            for (size_t j = 0; j < cv2Size; j++) {
-                if (isFirstAdd[i + j] == true) {
-                    cvMult[i + j]     = cv1[i] * cv2[j];
-                    isFirstAdd[i + j] = false;
-                }
-                else {
-                    cvMult[i + j] += cv1[i] * cv2[j];
-                }
-            }
+            ext.SetFormat(Format::EVALUATION);
         }
     }
-#else
-    std::vector<bool> isFirstAdd(cvMultSize, true);
 
-    for (size_t i = 0; i < cv1Size; i++) {
-        for (size_t j = 0; j < cv2Size; j++) {
-            if (isFirstAdd[i + j] == true) {
-                cvMult[i + j]     = cv1[i] * cv2[j];
-                isFirstAdd[i + j] = false;
-            }
-            else {
-                cvMult[i + j] += cv1[i] * cv2[j];
-            }
-        }
-    }
-#endif
+    std::vector<DCRTPoly> cvMult = TensorProduct(cv1Ext, cv2Ext);
 
-    if (cryptoParams->GetMultiplicationTechnique() == HPS) {
-        for (size_t i = 0; i < cvMultSize; i++) {
-            // converts to coefficient representation before rounding
-            cvMult[i].SetFormat(Format::COEFFICIENT);
+    const NativeInteger& t = cryptoParams->GetPlaintextModulus();
+#pragma omp parallel for if (parallelElements)
+    for (size_t k = 0; k < cvMultSize; k++) {
+        // converts to coefficient representation before rounding
+        cvMult[k].SetFormat(Format::COEFFICIENT);
+        if (technique == HPS) {
             // Performs the scaling by t/Q followed by rounding; the result is in the
             // CRT basis P
-            cvMult[i] =
-                cvMult[i].ScaleAndRound(cryptoParams->GetParamsRl(), cryptoParams->GettRSHatInvModsDivsModr(),
+            cvMult[k] =
+                cvMult[k].ScaleAndRound(cryptoParams->GetParamsRl(), cryptoParams->GettRSHatInvModsDivsModr(),
                                         cryptoParams->GettRSHatInvModsDivsFrac(), cryptoParams->GetModrBarrettMu());
 
             // Converts from the CRT basis P to Q
-            cvMult[i] = cvMult[i].SwitchCRTBasis(cryptoParams->GetElementParams(), cryptoParams->GetRlHatInvModr(),
+            cvMult[k] = cvMult[k].SwitchCRTBasis(cryptoParams->GetElementParams(), cryptoParams->GetRlHatInvModr(),
                                                  cryptoParams->GetRlHatInvModrPrecon(), cryptoParams->GetRlHatModq(),
                                                  cryptoParams->GetalphaRlModq(), cryptoParams->GetModqBarrettMu(),
                                                  cryptoParams->GetrInv());
         }
-    }
-    else if (cryptoParams->GetMultiplicationTechnique() == HPSPOVERQ) {
-        for (size_t i = 0; i < cvMultSize; i++) {
-            cvMult[i].SetFormat(COEFFICIENT);
+        else if (technique == HPSPOVERQ) {
             // Performs the scaling by t/P followed by rounding; the result is in the
             // CRT basis Q
-            cvMult[i] =
-                cvMult[i].ScaleAndRound(cryptoParams->GetElementParams(), cryptoParams->GettQlSlHatInvModsDivsModq(0),
+            cvMult[k] =
+                cvMult[k].ScaleAndRound(cryptoParams->GetElementParams(), cryptoParams->GettQlSlHatInvModsDivsModq(0),
                                         cryptoParams->GettQlSlHatInvModsDivsFrac(0), cryptoParams->GetModqBarrettMu());
         }
-    }
-    else if (cryptoParams->GetMultiplicationTechnique() == HPSPOVERQLEVELED) {
-        for (size_t i = 0; i < cvMultSize; i++) {
-            cvMult[i].SetFormat(COEFFICIENT);
+        else if (technique == HPSPOVERQLEVELED) {
             // Performs the scaling by t/P followed by rounding; the result is in the
             // CRT basis Q
-            cvMult[i] =
-                cvMult[i].ScaleAndRound(cryptoParams->GetParamsQl(l), cryptoParams->GettQlSlHatInvModsDivsModq(l),
+            cvMult[k] =
+                cvMult[k].ScaleAndRound(cryptoParams->GetParamsQl(l), cryptoParams->GettQlSlHatInvModsDivsModq(l),
                                         cryptoParams->GettQlSlHatInvModsDivsFrac(l), cryptoParams->GetModqBarrettMu());
 
             if (l < sizeQ - 1) {
                 // Expand back to basis Q.
-                cvMult[i].ExpandCRTBasisQlHat(cryptoParams->GetElementParams(), cryptoParams->GetQlHatModq(l),
+                cvMult[k].ExpandCRTBasisQlHat(cryptoParams->GetElementParams(), cryptoParams->GetQlHatModq(l),
                                               cryptoParams->GetQlHatModqPrecon(l), sizeQ);
             }
         }
-    }
-    else {
-        const NativeInteger& t = cryptoParams->GetPlaintextModulus();
-        for (size_t i = 0; i < cvMultSize; i++) {
-            // converts to Format::COEFFICIENT representation before rounding
-            cvMult[i].SetFormat(Format::COEFFICIENT);
+        else {
             // Performs the scaling by t/Q followed by rounding; the result is in the
             // CRT basis {Bsk}
-            cvMult[i].FastRNSFloorq(
+            cvMult[k].FastRNSFloorq(
                 t, cryptoParams->GetModuliQ(), cryptoParams->GetModuliBsk(), cryptoParams->GetModbskBarrettMu(),
                 cryptoParams->GettQHatInvModq(), cryptoParams->GettQHatInvModqPrecon(), cryptoParams->GetQHatModbsk(),
                 cryptoParams->GetqInvModbsk(), cryptoParams->GettQInvModbsk(), cryptoParams->GettQInvModbskPrecon());
 
             // Converts from the CRT basis {Bsk} to {Q}
-            cvMult[i].FastBaseConvSK(cryptoParams->GetElementParams(), cryptoParams->GetModqBarrettMu(),
+            cvMult[k].FastBaseConvSK(cryptoParams->GetElementParams(), cryptoParams->GetModqBarrettMu(),
                                      cryptoParams->GetModuliBsk(), cryptoParams->GetModbskBarrettMu(),
                                      cryptoParams->GetBHatInvModb(), cryptoParams->GetBHatInvModbPrecon(),
                                      cryptoParams->GetBHatModmsk(), cryptoParams->GetBInvModmsk(),
@@ -524,7 +468,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalSquare(ConstCiphertext<DCRTPoly> ciph
             cvSquare[0] = cv[0] * cv[0];  // a
             cvSquare[2] = cv[1] * cv[1];  // b
 
-            cvSquare[1] = cv1[0] * cv1[1];
+            cvSquare[1] = cv[0] * cv[1];
             cvSquare[1] += cvSquare[1];
         }
         else {
@@ -745,8 +689,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalAutomorphism(ConstCiphertext<DCRTPoly
 
     usint N = cv[0].GetRingDimension();
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, i, &vec);
+    const auto& vec = GetAutoMap(N, i);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
@@ -828,8 +771,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
     }
 
     usint N = cryptoParams->GetElementParams()->GetRingDimension();
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
+    const auto& vec = GetAutoMap(N, autoIndex);
 
     (*ba)[0] += cv[0];
 
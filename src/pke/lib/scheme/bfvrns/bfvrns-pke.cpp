@@ -97,6 +97,16 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGen(CryptoContext<DCRTPoly> cc, bool makeSparse)
     return keyPair;
 }
 
+DCRTPoly PKEBFVRNS::ExtendPlaintext(const DCRTPoly& ptxt, const std::shared_ptr<ParmType> params,
+                                    PlaintextModulus t) const {
+    // a plaintext below q_0 / 2 is already given exactly by its first tower, so there is no need to interpolate
+    // it over Q with multiprecision arithmetic
+    const NativeInteger& q0 = ptxt.GetElementAtIndex(0).GetModulus();
+    if (NativeInteger(t) < (q0 >> 1))
+        return DCRTPoly(ptxt.GetElementAtIndex(0), params);
+    return DCRTPoly(ptxt.CRTInterpolate(), params);
+}
+
 Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PrivateKey<DCRTPoly> privateKey) const {
     Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(privateKey));
 
@@ -109,14 +119,13 @@ Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PrivateKey<DCRTPoly
     if (cryptoParams->GetEncryptionTechnique() == EXTENDED) {
         encParams = cryptoParams->GetParamsQr();
         ptxt.SetFormat(Format::COEFFICIENT);
-        Poly bigPtxt = ptxt.CRTInterpolate();
-        DCRTPoly plain(bigPtxt, encParams);
-        ptxt     = plain;
+        ptxt     = ExtendPlaintext(ptxt, encParams, cryptoParams->GetPlaintextModulus());
         tInvModq = cryptoParams->GettInvModqr();
     }
     ptxt.SetFormat(Format::COEFFICIENT);
 
-    std::shared_ptr<std::vector<DCRTPoly>> ba = EncryptZeroCore(privateKey, encParams);
+    const PRNGSeed seed                       = PseudoRandomNumberGenerator::GenerateSeed();
+    std::shared_ptr<std::vector<DCRTPoly>> ba = EncryptZeroCore(privateKey, encParams, seed);
 
     NativeInteger NegQModt       = cryptoParams->GetNegQModt();
     NativeInteger NegQModtPrecon = cryptoParams->GetNegQModtPrecon();
@@ -144,6 +153,9 @@ Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PrivateKey<DCRTPoly
     (*ba)[1].SetFormat(Format::EVALUATION);
 
     ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    // the second element is only rescaled with EXTENDED encryption
+    if (cryptoParams->GetEncryptionTechnique() != EXTENDED)
+        ciphertext->SetElementSeed(seed);
     ciphertext->SetNoiseScaleDeg(1);
 
     return ciphertext;
@@ -161,9 +173,7 @@ Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PublicKey<DCRTPoly>
     if (cryptoParams->GetEncryptionTechnique() == EXTENDED) {
         encParams = cryptoParams->GetParamsQr();
         ptxt.SetFormat(Format::COEFFICIENT);
-        Poly bigPtxt = ptxt.CRTInterpolate();
-        DCRTPoly plain(bigPtxt, encParams);
-        ptxt     = plain;
+        ptxt     = ExtendPlaintext(ptxt, encParams, cryptoParams->GetPlaintextModulus());
         tInvModq = cryptoParams->GettInvModqr();
     }
     ptxt.SetFormat(Format::COEFFICIENT);
@@ -39,10 +39,12 @@ BGV implementation. See https://eprint.iacr.org/2021/204 for details.
 
 #include "scheme/bgvrns/bgvrns-cryptoparameters.h"
 #include "ciphertext.h"
+#include "utils/opcounters.h"
 
 namespace lbcrypto {
 
 void LeveledSHEBGVRNS::ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertext, size_t levels) const {
+    OpCounterScope opCount(OPCOUNT_RESCALE, levels);
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersBGVRNS>(ciphertext->GetCryptoParameters());
 
     const auto t = ciphertext->GetCryptoParameters()->GetPlaintextModulus();
@@ -47,7 +47,8 @@ namespace lbcrypto {
 //------------------------------------------------------------------------------
 
 void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
-                                    std::vector<uint32_t> dim1, uint32_t numSlots, uint32_t correctionFactor) {
+                                    std::vector<uint32_t> dim1, uint32_t numSlots, uint32_t correctionFactor,
+                                    bool precompute) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -119,27 +120,6 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
     precom->m_paramsEnc = GetCollapsedFFTParams(slots, newBudget[0], dim1[0]);
     precom->m_paramsDec = GetCollapsedFFTParams(slots, newBudget[1], dim1[1]);
 
-    uint32_t m    = 4 * slots;
-    bool isSparse = (M != m) ? true : false;
-
-    // computes indices for all primitive roots of unity
-    std::vector<uint32_t> rotGroup(slots);
-    uint32_t fivePows = 1;
-    for (uint32_t i = 0; i < slots; ++i) {
-        rotGroup[i] = fivePows;
-        fivePows *= 5;
-        fivePows %= m;
-    }
-
-    // computes all powers of a primitive root of unity exp(2 * M_PI/m)
-    std::vector<std::complex<double>> ksiPows(m + 1);
-    for (uint32_t j = 0; j < m; ++j) {
-        double angle = 2.0 * M_PI * j / m;
-        ksiPows[j].real(cos(angle));
-        ksiPows[j].imag(sin(angle));
-    }
-    ksiPows[m] = ksiPows[0];
-
     // Extract the modulus prior to bootstrapping
     NativeInteger q = cryptoParams->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt();
     double qDouble  = q.ConvertToDouble();
@@ -166,38 +146,72 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
     uint32_t lEnc = L0 - precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] - 1;
     uint32_t lDec = L0 - depthBT;
 
-    bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
-                         (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
+    precom->m_precompute = precompute;
+    precom->m_scaleEnc   = scaleEnc;
+    precom->m_scaleDec   = scaleDec;
+    precom->m_levelEnc   = lEnc;
+    precom->m_levelDec   = lDec;
 
-    if (isLTBootstrap) {
-        // allocate all vectors
-        std::vector<std::vector<std::complex<double>>> U0(slots, std::vector<std::complex<double>>(slots));
-        std::vector<std::vector<std::complex<double>>> U1(slots, std::vector<std::complex<double>>(slots));
-        std::vector<std::vector<std::complex<double>>> U0hatT(slots, std::vector<std::complex<double>>(slots));
-        std::vector<std::vector<std::complex<double>>> U1hatT(slots, std::vector<std::complex<double>>(slots));
+    // plaintexts cached for an earlier setup with the same number of slots are stale now
+    ClearBootstrapCache(slots);
 
-        for (size_t i = 0; i < slots; i++) {
-            for (size_t j = 0; j < slots; j++) {
-                U0[i][j]     = ksiPows[(j * rotGroup[i]) % m];
-                U0hatT[j][i] = std::conj(U0[i][j]);
-                U1[i][j]     = std::complex<double>(0, 1) * U0[i][j];
-                U1hatT[j][i] = std::conj(U1[i][j]);
-            }
-        }
+    if (precompute) {
+        EncodeBootstrapTransform(cc, *precom, true, precom->m_U0hatTPre, precom->m_U0hatTPreFFT);
+        EncodeBootstrapTransform(cc, *precom, false, precom->m_U0Pre, precom->m_U0PreFFT);
+    }
+}
 
-        if (!isSparse) {
-            precom->m_U0hatTPre = EvalLinearTransformPrecompute(cc, U0hatT, scaleEnc, lEnc);
-            precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, scaleDec, lDec);
-        }
-        else {
-            precom->m_U0hatTPre = EvalLinearTransformPrecompute(cc, U0hatT, U1hatT, 0, scaleEnc, lEnc);
-            precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, U1, 1, scaleDec, lDec);
-        }
+void FHECKKSRNS::SetBootstrapCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_bootCacheMutex);
+    m_bootCacheBudget = bytes;
+    while (!m_bootCache.empty() && m_bootCacheBytes > m_bootCacheBudget) {
+        m_bootCacheBytes -= m_bootCache.back().bytes;
+        m_bootCache.pop_back();
     }
-    else {
-        precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-        precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+}
+
+CKKSBootstrapArtifact FHECKKSRNS::GetBootstrapArtifact(const CryptoContextImpl<DCRTPoly>& cc, uint32_t slots) const {
+    if (slots == 0)
+        slots = cc.GetCyclotomicOrder() / 4;
+
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end()) {
+        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalBootstrapSetup to proceed"));
+        OPENFHE_THROW(type_error, errorMsg);
     }
+
+    CKKSBootstrapArtifact artifact;
+    artifact.ringDim          = cc.GetRingDimension();
+    artifact.correctionFactor = m_correctionFactor;
+    for (const auto& params : cc.GetCryptoParameters()->GetElementParams()->GetParams())
+        artifact.moduli.push_back(params->GetModulus());
+    artifact.precom = pair->second;
+    return artifact;
+}
+
+void FHECKKSRNS::SetBootstrapArtifact(const CryptoContextImpl<DCRTPoly>& cc, const CKKSBootstrapArtifact& artifact) {
+    if (artifact.precom == nullptr)
+        OPENFHE_THROW(config_error, "The bootstrapping precomputation is empty");
+    if (artifact.ringDim != cc.GetRingDimension())
+        OPENFHE_THROW(config_error, "The bootstrapping precomputation was generated for ring dimension " +
+                                        std::to_string(artifact.ringDim));
+
+    const auto& params = cc.GetCryptoParameters()->GetElementParams()->GetParams();
+    bool sameModuli    = (artifact.moduli.size() == params.size());
+    for (size_t i = 0; sameModuli && i < params.size(); ++i)
+        sameModuli = (artifact.moduli[i] == params[i]->GetModulus());
+    if (!sameModuli)
+        OPENFHE_THROW(config_error, "The bootstrapping precomputation was generated for a different modulus chain");
+
+    uint32_t slots = artifact.precom->m_slots;
+    if (slots == 0 || slots > cc.GetCyclotomicOrder() / 4)
+        OPENFHE_THROW(config_error, "Invalid number of slots in the bootstrapping precomputation");
+
+    m_correctionFactor     = artifact.correctionFactor;
+    m_bootPrecomMap[slots] = artifact.precom;
+    ClearBootstrapCache(slots);
 }
 
 std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKeyGen(
@@ -226,6 +240,35 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKey
     return evalKeys;
 }
 
+static size_t GetPlaintextsMemoryUsage(const std::vector<ConstPlaintext>& plaintexts) {
+    size_t bytes = 0;
+    for (const auto& pt : plaintexts) {
+        if (pt)
+            bytes += pt->GetMemoryUsage();
+    }
+    return bytes;
+}
+
+size_t CKKSBootstrapPrecom::GetMemoryUsage() const {
+    size_t bytes = sizeof(*this) + (m_paramsEnc.size() + m_paramsDec.size()) * sizeof(int32_t);
+    bytes += GetPlaintextsMemoryUsage(m_U0Pre) + GetPlaintextsMemoryUsage(m_U0hatTPre);
+    for (const auto* levels : {&m_U0PreFFT, &m_U0hatTPreFFT}) {
+        for (const auto& plaintexts : *levels)
+            bytes += GetPlaintextsMemoryUsage(plaintexts);
+    }
+    return bytes;
+}
+
+size_t FHECKKSRNS::GetMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& precom : m_bootPrecomMap) {
+        if (precom.second)
+            bytes += precom.second->GetMemoryUsage();
+    }
+    std::lock_guard<std::mutex> lock(m_bootCacheMutex);
+    return bytes + m_bootCacheBytes;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                                uint32_t precision) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
@@ -414,8 +457,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
     Ciphertext<DCRTPoly> ctxtDec;
 
-    bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
-                         (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
     if (slots == M / 4) {
         //------------------------------------------------------------------------------
         // FULLY PACKED CASE
@@ -433,8 +474,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
         // only one linear transform is needed as the other one can be derived
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtEnc = EvalBootstrapTransform(*precom, raised, true);
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
         auto conj       = Conjugate(ctxtEnc, evalKeyMap);
@@ -500,8 +540,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // Only one linear transform is needed
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = EvalBootstrapTransform(*precom, ctxtEnc, false);
     }
     else {
         //------------------------------------------------------------------------------
@@ -527,8 +566,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtEnc = EvalBootstrapTransform(*precom, raised, true);
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
         auto conj       = Conjugate(ctxtEnc, evalKeyMap);
@@ -594,8 +632,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // linear transform for decoding
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = EvalBootstrapTransform(*precom, ctxtEnc, false);
 
         cc->EvalAddInPlace(ctxtDec, cc->EvalRotate(ctxtDec, slots));
     }
@@ -1474,13 +1511,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
     auto cc = ct->GetCryptoContext();
+    // the hoisted rotations below need a relinearized input
+    ct = cc->RelinearizeLazy(ct);
     // Computing the baby-step bStep and the giant-step gStep.
     uint32_t bStep = (precom->m_dim1 == 0) ? ceil(sqrt(slots)) : precom->m_dim1;
     uint32_t gStep = ceil(static_cast<double>(slots) / bStep);
 
-    uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
-
     // computes the NTTs for each CRT limb (for the hoisted automorphisms used
     // later on)
     auto digits = cc->EvalFastRotationPrecompute(ct);
@@ -1494,43 +1530,24 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     }
 
     Ciphertext<DCRTPoly> result;
-    DCRTPoly first;
+    auto ctExt = cc->KeySwitchExt(ct, true);
 
     for (uint32_t j = 0; j < gStep; j++) {
-        Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), A[bStep * j]);
+        Ciphertext<DCRTPoly> inner = EvalMultExt(ctExt, A[bStep * j]);
         for (uint32_t i = 1; i < bStep; i++) {
             if (bStep * j + i < slots) {
                 EvalAddExtInPlace(inner, EvalMultExt(fastRotation[i - 1], A[bStep * j + i]));
             }
         }
 
-        if (j == 0) {
-            first         = cc->KeySwitchDownFirstElement(inner);
-            auto elements = inner->GetElements();
-            elements[0].SetValuesToZero();
-            inner->SetElements(elements);
+        if (j == 0)
             result = inner;
-        }
-        else {
-            inner = cc->KeySwitchDown(inner);
-            // Find the automorphism index that corresponds to rotation index index.
-            usint autoIndex = FindAutomorphismIndex2nComplex(bStep * j, M);
-            std::vector<usint> map(N);
-            PrecomputeAutoMap(N, autoIndex, &map);
-            DCRTPoly firstCurrent = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-            first += firstCurrent;
-
-            auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-            EvalAddExtInPlace(result, cc->EvalFastRotationExt(inner, bStep * j, innerDigits, false));
-        }
+        else
+            EvalRotateAddExtInPlace(result, inner, bStep * j);
     }
 
-    result        = cc->KeySwitchDown(result);
-    auto elements = result->GetElements();
-    elements[0] += first;
-    result->SetElements(elements);
-
-    return result;
+    // a single scaling down, the giant-step sums are kept in P*Q
+    return cc->KeySwitchDown(result);
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector<ConstPlaintext>>& A,
@@ -1548,7 +1565,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     auto cc    = ctxt->GetCryptoContext();
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
+    ctxt       = cc->RelinearizeLazy(ctxt);
 
     int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1632,7 +1649,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
         }
 
         Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
         for (int32_t i = 0; i < b; i++) {
             // for the first iteration with j=0:
             int32_t G                  = g * i;
@@ -1645,35 +1661,17 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
 
             if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
                 outer = inner;
             }
+            else if (rot_out[s][i] != 0) {
+                EvalRotateAddExtInPlace(outer, inner, rot_out[s][i]);
+            }
             else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
+                EvalAddExtInPlace(outer, inner);
             }
         }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        // a single scaling down per level, the giant-step sums are kept in P*Q
+        result = cc->KeySwitchDown(outer);
     }
 
     if (flagRem) {
@@ -1694,7 +1692,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
         }
 
         Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
         for (int32_t i = 0; i < bRem; i++) {
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
@@ -1708,36 +1705,18 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
 
             if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
                 outer = inner;
             }
+            else if (rot_out[stop][i] != 0) {
+                EvalRotateAddExtInPlace(outer, inner, rot_out[stop][i]);
+            }
             else {
-                if (rot_out[stop][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[stop][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[stop][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
+                EvalAddExtInPlace(outer, inner);
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        // a single scaling down per level, the giant-step sums are kept in P*Q
+        result = cc->KeySwitchDown(outer);
     }
 
     return result;
@@ -1758,9 +1737,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
     auto cc = ctxt->GetCryptoContext();
+    // the input comes from the approximation of the modular reduction and may not be relinearized yet
+    ctxt = cc->RelinearizeLazy(ctxt);
 
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1844,7 +1824,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
         }
 
         Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
         for (int32_t i = 0; i < b; i++) {
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
@@ -1858,36 +1837,18 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
 
             if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
                 outer = inner;
             }
+            else if (rot_out[s][i] != 0) {
+                EvalRotateAddExtInPlace(outer, inner, rot_out[s][i]);
+            }
             else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
+                EvalAddExtInPlace(outer, inner);
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        // a single scaling down per level, the giant-step sums are kept in P*Q
+        result = cc->KeySwitchDown(outer);
     }
 
     if (flagRem) {
@@ -1908,7 +1869,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
         }
 
         Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
         for (int32_t i = 0; i < bRem; i++) {
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
@@ -1921,36 +1881,18 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
 
             if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
                 outer = inner;
             }
+            else if (rot_out[s][i] != 0) {
+                EvalRotateAddExtInPlace(outer, inner, rot_out[s][i]);
+            }
             else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
+                EvalAddExtInPlace(outer, inner);
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        // a single scaling down per level, the giant-step sums are kept in P*Q
+        result = cc->KeySwitchDown(outer);
     }
 
     return result;
@@ -2013,6 +1955,143 @@ void FHECKKSRNS::AdjustCiphertext(Ciphertext<DCRTPoly>& ciphertext, double corre
     }
 }
 
+void FHECKKSRNS::ClearBootstrapCache(uint32_t slots) {
+    std::lock_guard<std::mutex> lock(m_bootCacheMutex);
+    for (auto it = m_bootCache.begin(); it != m_bootCache.end();) {
+        if (it->slots == slots) {
+            m_bootCacheBytes -= it->bytes;
+            it = m_bootCache.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void FHECKKSRNS::EncodeBootstrapTransform(const CryptoContextImpl<DCRTPoly>& cc, const CKKSBootstrapPrecom& precom,
+                                          bool encoding, std::vector<ConstPlaintext>& linear,
+                                          std::vector<std::vector<ConstPlaintext>>& fft) const {
+    uint32_t slots = precom.m_slots;
+    uint32_t m     = 4 * slots;
+    bool isSparse  = (cc.GetCyclotomicOrder() != m) ? true : false;
+    double scale   = encoding ? precom.m_scaleEnc : precom.m_scaleDec;
+    uint32_t L     = encoding ? precom.m_levelEnc : precom.m_levelDec;
+
+    // computes indices for all primitive roots of unity
+    std::vector<uint32_t> rotGroup(slots);
+    uint32_t fivePows = 1;
+    for (uint32_t i = 0; i < slots; ++i) {
+        rotGroup[i] = fivePows;
+        fivePows *= 5;
+        fivePows %= m;
+    }
+
+    // computes all powers of a primitive root of unity exp(2 * M_PI/m)
+    std::vector<std::complex<double>> ksiPows(m + 1);
+    for (uint32_t j = 0; j < m; ++j) {
+        double angle = 2.0 * M_PI * j / m;
+        ksiPows[j].real(cos(angle));
+        ksiPows[j].imag(sin(angle));
+    }
+    ksiPows[m] = ksiPows[0];
+
+    bool isLTBootstrap = (precom.m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
+                         (precom.m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
+
+    if (isLTBootstrap) {
+        // only the matrices for the requested direction are built: U0 and U1 = i*U0 for decoding,
+        // their conjugate transposes for encoding; U1 is needed in the sparse case only
+        std::vector<std::vector<std::complex<double>>> U0(slots, std::vector<std::complex<double>>(slots));
+        std::vector<std::vector<std::complex<double>>> U1;
+        if (isSparse)
+            U1.assign(slots, std::vector<std::complex<double>>(slots));
+
+        for (size_t i = 0; i < slots; i++) {
+            for (size_t j = 0; j < slots; j++) {
+                auto u0 = ksiPows[(j * rotGroup[i]) % m];
+                if (encoding) {
+                    U0[j][i] = std::conj(u0);
+                    if (isSparse)
+                        U1[j][i] = std::conj(std::complex<double>(0, 1) * u0);
+                }
+                else {
+                    U0[i][j] = u0;
+                    if (isSparse)
+                        U1[i][j] = std::complex<double>(0, 1) * u0;
+                }
+            }
+        }
+
+        linear = (!isSparse) ? EvalLinearTransformPrecompute(cc, U0, scale, L) :
+                               EvalLinearTransformPrecompute(cc, U0, U1, encoding ? 0 : 1, scale, L);
+    }
+    else {
+        fft = encoding ? EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scale, L) :
+                         EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scale, L);
+    }
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrapTransform(const CKKSBootstrapPrecom& precom,
+                                                        ConstCiphertext<DCRTPoly> ctxt, bool encoding) const {
+    bool isLTBootstrap = (precom.m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
+                         (precom.m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
+
+    if (precom.m_precompute) {
+        if (isLTBootstrap)
+            return EvalLinearTransform(encoding ? precom.m_U0hatTPre : precom.m_U0Pre, ctxt);
+        return encoding ? EvalCoeffsToSlots(precom.m_U0hatTPreFFT, ctxt) : EvalSlotsToCoeffs(precom.m_U0PreFFT, ctxt);
+    }
+
+    std::shared_ptr<const std::vector<ConstPlaintext>> linear;
+    std::shared_ptr<const std::vector<std::vector<ConstPlaintext>>> fft;
+    {
+        std::lock_guard<std::mutex> lock(m_bootCacheMutex);
+        for (auto it = m_bootCache.begin(); it != m_bootCache.end(); ++it) {
+            if (it->slots == precom.m_slots && it->encoding == encoding) {
+                m_bootCache.splice(m_bootCache.begin(), m_bootCache, it);
+                linear = it->linear;
+                fft    = it->fft;
+                break;
+            }
+        }
+    }
+
+    if (!linear) {
+        // encode outside of the lock; a concurrent caller may do the same, in which case
+        // the entry inserted last wins
+        auto newLinear = std::make_shared<std::vector<ConstPlaintext>>();
+        auto newFFT    = std::make_shared<std::vector<std::vector<ConstPlaintext>>>();
+        EncodeBootstrapTransform(*ctxt->GetCryptoContext(), precom, encoding, *newLinear, *newFFT);
+        linear = newLinear;
+        fft    = newFFT;
+
+        size_t bytes = GetPlaintextsMemoryUsage(*linear);
+        for (const auto& plaintexts : *fft)
+            bytes += GetPlaintextsMemoryUsage(plaintexts);
+
+        std::lock_guard<std::mutex> lock(m_bootCacheMutex);
+        if (bytes <= m_bootCacheBudget) {
+            for (auto it = m_bootCache.begin(); it != m_bootCache.end(); ++it) {
+                if (it->slots == precom.m_slots && it->encoding == encoding) {
+                    m_bootCacheBytes -= it->bytes;
+                    m_bootCache.erase(it);
+                    break;
+                }
+            }
+            m_bootCache.push_front({precom.m_slots, encoding, bytes, linear, fft});
+            m_bootCacheBytes += bytes;
+            while (m_bootCacheBytes > m_bootCacheBudget) {
+                m_bootCacheBytes -= m_bootCache.back().bytes;
+                m_bootCache.pop_back();
+            }
+        }
+    }
+
+    if (isLTBootstrap)
+        return EvalLinearTransform(*linear, ctxt);
+    return encoding ? EvalCoeffsToSlots(*fft, ctxt) : EvalSlotsToCoeffs(*fft, ctxt);
+}
+
 void FHECKKSRNS::ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext) const {
     auto cc = ciphertext->GetCryptoContext();
 
@@ -2360,6 +2439,40 @@ void FHECKKSRNS::EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphe
     }
 }
 
+void FHECKKSRNS::EvalRotateAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                         int32_t index) const {
+    const auto cc           = ciphertext2->GetCryptoContext();
+    const auto cryptoParams = ciphertext2->GetCryptoParameters();
+    auto algo               = cc->GetScheme();
+
+    uint32_t M      = cc->GetCyclotomicOrder();
+    uint32_t N      = cc->GetRingDimension();
+    usint autoIndex = FindAutomorphismIndex2nComplex(index, M);
+
+    const auto& evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext2->GetKeyTag());
+    auto evalKeyIterator   = evalKeyMap.find(autoIndex);
+    if (evalKeyIterator == evalKeyMap.end()) {
+        OPENFHE_THROW(openfhe_error, "EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+
+    const std::vector<DCRTPoly>& cv = ciphertext2->GetElements();
+
+    // only the second element is scaled down to Q to compute the digits; the first
+    // element is rotated in P*Q and scaled down together with the sum
+    auto second = ciphertext2->CloneEmpty();
+    second->SetElements({cv[1]});
+    DCRTPoly c1 = cc->KeySwitchDownFirstElement(second);
+
+    auto digits = algo->EvalKeySwitchPrecomputeCore(c1, cryptoParams);
+    auto cTilda = algo->EvalFastKeySwitchCoreExt(digits, evalKeyIterator->second, c1.GetParams());
+    (*cTilda)[0] += cv[0];
+
+    const auto& map              = GetAutoMap(N, autoIndex);
+    std::vector<DCRTPoly>& cvRes = ciphertext1->GetElements();
+    cvRes[0] += (*cTilda)[0].AutomorphismTransform(autoIndex, map);
+    cvRes[1] += (*cTilda)[1].AutomorphismTransform(autoIndex, map);
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1,
                                             ConstCiphertext<DCRTPoly> ciphertext2) const {
     Ciphertext<DCRTPoly> result = ciphertext1->Clone();
@@ -2393,8 +2506,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
     usint N                         = cv[0].GetRingDimension();
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, 2 * N - 1, &vec);
+    const auto& vec = GetAutoMap(N, 2 * N - 1);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
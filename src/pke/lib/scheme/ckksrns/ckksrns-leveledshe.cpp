@@ -39,6 +39,8 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 
 #include "schemebase/base-scheme.h"
 
+#include "utils/opcounters.h"
+
 namespace lbcrypto {
 
 /////////////////////////////////////////
@@ -102,6 +104,7 @@ void LeveledSHECKKSRNS::EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, double
 /////////////////////////////////////
 
 void LeveledSHECKKSRNS::ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertext, size_t levels) const {
+    OpCounterScope opCount(OPCOUNT_RESCALE, levels);
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     std::vector<DCRTPoly>& cv = ciphertext->GetElements();
@@ -440,8 +443,7 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRT
         (*cTilda)[0] += psiC0;
     }
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
+    const auto& vec = GetAutoMap(N, autoIndex);
 
     (*cTilda)[0] = (*cTilda)[0].AutomorphismTransform(autoIndex, vec);
     (*cTilda)[1] = (*cTilda)[1].AutomorphismTransform(autoIndex, vec);
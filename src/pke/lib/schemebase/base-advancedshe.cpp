@@ -33,6 +33,9 @@
 #include "key/privatekey.h"
 #include "cryptocontext.h"
 #include "schemebase/base-scheme.h"
+#include "utils/exception.h"
+
+#include <algorithm>
 
 namespace lbcrypto {
 
@@ -91,22 +94,45 @@ Ciphertext<Element> AdvancedSHEBase<Element>::EvalMultMany(const std::vector<Cip
     if (ciphertextVec.size() < 1)
         OPENFHE_THROW(config_error, "Input ciphertext vector size should be 1 or more");
 
-    const size_t inSize = ciphertextVec.size();
-    const size_t lim    = inSize * 2 - 2;
-    std::vector<Ciphertext<Element>> ciphertextMultVec;
-    ciphertextMultVec.resize(inSize - 1);
-    size_t ctrIndex = 0;
-
     auto algo = ciphertextVec[0]->GetCryptoContext()->GetScheme();
 
-    for (size_t i = 0; i < lim; i = i + 2) {
-        ciphertextMultVec[ctrIndex] = algo->EvalMultAndRelinearize(
-            i < inSize ? ciphertextVec[i] : ciphertextMultVec[i - inSize],
-            i + 1 < inSize ? ciphertextVec[i + 1] : ciphertextMultVec[i + 1 - inSize], evalKeys);
-        algo->ModReduceInPlace(ciphertextMultVec[ctrIndex++], 1);
+    // depth consumed so far: levels dropped plus the scaling degree still to be reduced
+    auto depth = [](const Ciphertext<Element>& ciphertext) {
+        return ciphertext->GetLevel() + ciphertext->GetNoiseScaleDeg();
+    };
+
+    std::vector<Ciphertext<Element>> current(ciphertextVec);
+    while (current.size() > 1) {
+        // The tree is built level by level from the shallowest operands up, so operands of similar depth are
+        // paired and a deep input is multiplied in only once the others have caught up. The products of a level
+        // are independent; they run in parallel when there are enough of them to keep all threads busy.
+        std::stable_sort(current.begin(), current.end(),
+                         [&depth](const Ciphertext<Element>& a, const Ciphertext<Element>& b) {
+                             return depth(a) < depth(b);
+                         });
+
+        size_t numPairs = current.size() / 2;
+        std::vector<Ciphertext<Element>> next(numPairs + current.size() % 2);
+        bool parallelPairs =
+            numPairs > 1 && numPairs >= static_cast<size_t>(OpenFHEParallelControls.GetMachineThreads());
+
+        ThreadException e;
+#pragma omp parallel for if (parallelPairs)
+        for (size_t i = 0; i < numPairs; i++) {
+            e.Run([&]() {
+                next[i] = algo->EvalMultAndRelinearize(current[2 * i], current[2 * i + 1], evalKeys);
+                algo->ModReduceInPlace(next[i], 1);
+            });
+        }
+        e.Rethrow();
+
+        // an odd operand out is the deepest one; it waits for the next level
+        if (current.size() % 2)
+            next.back() = current.back();
+        current = std::move(next);
     }
 
-    return ciphertextMultVec.back();
+    return current[0];
 }
 
 template <class Element>
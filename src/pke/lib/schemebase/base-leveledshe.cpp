@@ -442,8 +442,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalAutomorphism(ConstCiphertext<El
     //        not_available_error,
     //        "automorphism indices higher than 2*n are not allowed " + CALLER_INFO);
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, i, &vec);
+    const auto& vec = GetAutoMap(N, i);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
@@ -481,7 +480,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
 
     usint autoIndex = FindAutomorphismIndex(index, m);
 
-    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    const auto& evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
     // verify if the key autoIndex exists in the evalKeyMap
     auto evalKeyIterator = evalKeyMap.find(autoIndex);
     if (evalKeyIterator == evalKeyMap.end()) {
@@ -497,8 +496,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
     const auto cryptoParams = ciphertext->GetCryptoParameters();
 
     usint N = cryptoParams->GetElementParams()->GetRingDimension();
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
+    const auto& vec = GetAutoMap(N, autoIndex);
 
     (*ba)[0] += cv[0];
 
@@ -650,21 +648,50 @@ void LeveledSHEBase<Element>::EvalSubCoreInPlace(Ciphertext<Element>& ciphertext
 }
 
 template <class Element>
-Ciphertext<Element> LeveledSHEBase<Element>::EvalMultCore(ConstCiphertext<Element> ciphertext1,
-                                                          ConstCiphertext<Element> ciphertext2) const {
-    Ciphertext<Element> result = ciphertext1->CloneZero();
-
-    std::vector<Element> cv1        = ciphertext1->GetElements();
-    const std::vector<Element>& cv2 = ciphertext2->GetElements();
-
+std::vector<Element> LeveledSHEBase<Element>::TensorProduct(const std::vector<Element>& cv1,
+                                                            const std::vector<Element>& cv2) {
     size_t cResultSize = cv1.size() + cv2.size() - 1;
     std::vector<Element> cvMult(cResultSize);
 
-    if (cv1.size() == 2 && cv2.size() == 2) {
-        cvMult[2] = (cv1[1] * cv2[1]);
-        cvMult[1] = (cv1[1] *= cv2[0]);
-        cvMult[0] = (cv2[0] * cv1[0]);
-        cvMult[1] += (cv1[0] *= cv2[1]);
+    // the result towers are laid out from the element parameters, so the fast path also requires that those
+    // describe every tower; BEHZ extends to the basis {q, Bsk} while keeping the parameters of Bsk only
+    bool karatsuba = cv1.size() == 2 && cv2.size() == 2 && cv1[0].GetFormat() == Format::EVALUATION &&
+                     cv1[0].GetNumOfElements() == cv2[0].GetNumOfElements() &&
+                     cv1[0].GetParams()->GetParams().size() == cv1[0].GetNumOfElements();
+    if (karatsuba) {
+        // (a0 + a1 s)(b0 + b1 s) = a0 b0 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) s + a1 b1 s^2,
+        // evaluated coefficient by coefficient so no intermediate polynomials are formed
+        const auto elementParams = cv1[0].GetParams();
+        for (auto& element : cvMult)
+            element = Element(elementParams, Format::EVALUATION);
+
+        size_t numTowers = cv1[0].GetNumOfElements();
+#pragma omp parallel for
+        for (size_t i = 0; i < numTowers; i++) {
+            const auto& a0 = cv1[0].GetElementAtIndex(i).GetValues();
+            const auto& a1 = cv1[1].GetElementAtIndex(i).GetValues();
+            const auto& b0 = cv2[0].GetElementAtIndex(i).GetValues();
+            const auto& b1 = cv2[1].GetElementAtIndex(i).GetValues();
+
+            const auto& modulus = a0.GetModulus();
+            const auto mu       = modulus.ComputeMu();
+            size_t ringDim      = a0.GetLength();
+
+            typename Element::PolyType::Vector d0(ringDim, modulus);
+            typename Element::PolyType::Vector d1(ringDim, modulus);
+            typename Element::PolyType::Vector d2(ringDim, modulus);
+            for (size_t j = 0; j < ringDim; j++) {
+                d0[j] = a0[j].ModMulFast(b0[j], modulus, mu);
+                d2[j] = a1[j].ModMulFast(b1[j], modulus, mu);
+                d1[j] = a0[j].ModAddFast(a1[j], modulus).ModMulFast(b0[j].ModAddFast(b1[j], modulus), modulus, mu);
+                d1[j].ModSubFastEq(d0[j], modulus);
+                d1[j].ModSubFastEq(d2[j], modulus);
+            }
+
+            cvMult[0].ElementAtIndex(i).SetValues(std::move(d0), Format::EVALUATION);
+            cvMult[1].ElementAtIndex(i).SetValues(std::move(d1), Format::EVALUATION);
+            cvMult[2].ElementAtIndex(i).SetValues(std::move(d2), Format::EVALUATION);
+        }
     }
     else {
         std::vector<bool> isFirstAdd(cResultSize, true);
@@ -682,7 +709,15 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalMultCore(ConstCiphertext<Elemen
         }
     }
 
-    result->SetElements(std::move(cvMult));
+    return cvMult;
+}
+
+template <class Element>
+Ciphertext<Element> LeveledSHEBase<Element>::EvalMultCore(ConstCiphertext<Element> ciphertext1,
+                                                          ConstCiphertext<Element> ciphertext2) const {
+    Ciphertext<Element> result = ciphertext1->CloneZero();
+
+    result->SetElements(TensorProduct(ciphertext1->GetElements(), ciphertext2->GetElements()));
     result->SetNoiseScaleDeg(ciphertext1->GetNoiseScaleDeg() + ciphertext2->GetNoiseScaleDeg());
     result->SetScalingFactor(ciphertext1->GetScalingFactor() * ciphertext2->GetScalingFactor());
     const auto plainMod = ciphertext1->GetCryptoParameters()->GetPlaintextModulus();
@@ -284,6 +284,37 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
             }
         }
 
+        // Pre-compute the bases used by every key switch at level l:
+        // {Q_l}, {Q_l,P} and the last (possibly incomplete) digit of Q_l
+        m_paramsPartQl.resize(sizeQ);
+        m_paramsQlKS.resize(sizeQ);
+        m_paramsQlP.resize(sizeQ);
+        for (uint32_t l = 0; l < sizeQ; l++) {
+            std::vector<NativeInteger> moduliQl(moduliQ.begin(), moduliQ.begin() + l + 1);
+            std::vector<NativeInteger> rootsQl(rootsQ.begin(), rootsQ.begin() + l + 1);
+            m_paramsQlKS[l] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQl, rootsQl);
+
+            moduliQl.insert(moduliQl.end(), moduliP.begin(), moduliP.end());
+            rootsQl.insert(rootsQl.end(), rootsP.begin(), rootsP.end());
+            m_paramsQlP[l] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQl, rootsQl);
+
+            uint32_t lastPart        = ceil(static_cast<double>(l + 1) / alpha) - 1;
+            const auto& paramsPartQ  = GetParamsPartQ(lastPart);
+            uint32_t sizePartQl      = (l + 1) - alpha * lastPart;
+            if (sizePartQl == paramsPartQ->GetParams().size()) {
+                m_paramsPartQl[l] = paramsPartQ;
+                continue;
+            }
+            std::vector<NativeInteger> moduli(sizePartQl);
+            std::vector<NativeInteger> roots(sizePartQl);
+            for (uint32_t i = 0; i < sizePartQl; i++) {
+                moduli[i] = paramsPartQ->GetParams()[i]->GetModulus();
+                roots[i]  = paramsPartQ->GetParams()[i]->GetRootOfUnity();
+            }
+            m_paramsPartQl[l] = std::make_shared<ILDCRTParams<BigInteger>>(
+                ILDCRTParams<BigInteger>(paramsPartQ->GetCyclotomicOrder(), moduli, roots, {}, {}, BigInteger(0)));
+        }
+
         // Pre-compute values [Q^(l)_j/q_i)^{-1}]_{q_i}
         m_PartQlHatInvModq.resize(m_numPartQ);
         m_PartQlHatInvModqPrecon.resize(m_numPartQ);
@@ -40,13 +40,15 @@ Ciphertext<DCRTPoly> PKERNS::Encrypt(DCRTPoly plaintext, const PrivateKey<DCRTPo
     Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(privateKey));
 
     const std::shared_ptr<ParmType> ptxtParams = plaintext.GetParams();
-    std::shared_ptr<std::vector<DCRTPoly>> ba  = EncryptZeroCore(privateKey, ptxtParams);
+    const PRNGSeed seed                        = PseudoRandomNumberGenerator::GenerateSeed();
+    std::shared_ptr<std::vector<DCRTPoly>> ba  = EncryptZeroCore(privateKey, ptxtParams, seed);
 
     plaintext.SetFormat(EVALUATION);
 
     (*ba)[0] += plaintext;
 
     ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    ciphertext->SetElementSeed(seed);
     ciphertext->SetNoiseScaleDeg(1);
 
     return ciphertext;
@@ -110,16 +112,21 @@ DecryptResult PKERNS::Decrypt(ConstCiphertext<DCRTPoly> ciphertext, const Privat
 
 std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                                const std::shared_ptr<ParmType> params) const {
+    return EncryptZeroCore(privateKey, params, PseudoRandomNumberGenerator::GenerateSeed());
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                               const std::shared_ptr<ParmType> params,
+                                                               const PRNGSeed& seed) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
 
     const DCRTPoly& s  = privateKey->GetPrivateElement();
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
     const std::shared_ptr<ParmType> elementParams = (params == nullptr) ? cryptoParams->GetElementParams() : params;
 
-    DCRTPoly a(dug, elementParams, Format::EVALUATION);
+    DCRTPoly a(seed, elementParams, Format::EVALUATION);
     DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
     uint32_t sizeQ  = s.GetParams()->GetParams().size();
@@ -117,6 +117,32 @@ TEST_F(UTGENERAL_ENCODING, packed_int_ptxt_encoding_negative) {
     EXPECT_EQ(se.GetPackedValue(), vectorOfInts1) << "packed int";
 }
 
+TEST_F(UTGENERAL_ENCODING, packed_int_ptxt_encoding_parallel_moduli) {
+    usint m                                   = 16;
+    std::vector<PlaintextModulus> moduli      = {17, 97, 113, 193, 241, 257};
+    std::vector<int64_t> vectorOfInts         = {1, 2, -3, 4, 5, -6, 7, 8};
+    std::shared_ptr<ILParams> lp              = ElemParamFactory::GenElemParams<ILParamsImpl<BigInteger>>(m);
+    std::vector<EncodingParams> encodingParams;
+    for (auto p : moduli)
+        encodingParams.push_back(std::make_shared<EncodingParamsImpl>(p));
+
+    // the tables are built lazily on first use and then shared by all threads using the same parameters
+    std::vector<int> matches(4 * moduli.size(), 0);
+#pragma omp parallel for
+    for (size_t i = 0; i < matches.size(); i++) {
+        PackedEncoding se(lp, encodingParams[i % moduli.size()], vectorOfInts);
+        se.Encode();
+        se.Decode();
+        se.SetLength(vectorOfInts.size());
+        matches[i] = (se.GetPackedValue() == vectorOfInts);
+    }
+
+    for (size_t i = 0; i < matches.size(); i++)
+        EXPECT_TRUE(matches[i]) << "packed int - modulus " << moduli[i % moduli.size()];
+    for (auto& ep : encodingParams)
+        EXPECT_TRUE(PackedEncoding::HasParams(m, ep));
+}
+
 TEST_F(UTGENERAL_ENCODING, packed_int_ptxt_encoding_DCRTPoly_prime_cyclotomics) {
     usint init_size   = 3;
     usint dcrtBits    = 24;
@@ -179,3 +179,44 @@ static void RunEvalMultManyTest(CryptoContext<Element> cryptoContext, std::strin
     EXPECT_EQ(*plaintextMul3, *plaintextResult3) << msg << ".EvalMultAndRelinearize gives incorrect results.\n";
     EXPECT_EQ(*plaintextMulMany, *plaintextResult3) << msg << ".EvalMultMany gives incorrect results.\n";
 }
+
+// EvalMultMany on an odd number of inputs of different depths
+TEST(UTGENERAL_EVAL_MULT_MANY, Poly_BFVrns_Eval_Mult_Many_Mixed_Depths) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(256);
+    parameters.SetStandardDeviation(4);
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetMaxRelinSkDeg(4);
+    parameters.SetScalingModSize(60);
+
+    CryptoContext<DCRTPoly> cryptoContext = GenCryptoContext(parameters);
+    cryptoContext->Enable(PKE);
+    cryptoContext->Enable(KEYSWITCH);
+    cryptoContext->Enable(LEVELEDSHE);
+    cryptoContext->Enable(ADVANCEDSHE);
+
+    auto keyPair = cryptoContext->KeyGen();
+    cryptoContext->EvalMultKeysGen(keyPair.secretKey);
+
+    auto encrypt = [&](const std::vector<int64_t>& values) {
+        return cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakeCoefPackedPlaintext(values));
+    };
+
+    auto squared = encrypt({2});
+    squared      = cryptoContext->EvalMult(squared, squared);
+
+    // the squared input goes first so it is not paired in input order
+    std::vector<Ciphertext<DCRTPoly>> cipherTextList = {squared, encrypt({5, 4, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0}),
+                                                        encrypt({2}), encrypt({3}), encrypt({1})};
+
+    auto ciphertextMulMany = cryptoContext->EvalMultMany(cipherTextList);
+
+    Plaintext plaintextMulMany;
+    cryptoContext->Decrypt(keyPair.secretKey, ciphertextMulMany, &plaintextMulMany);
+
+    std::vector<int64_t> expected = {120, 96, 72, 48, 24, 0, 120, 96, 72, 48, 24, 0};
+    Plaintext plaintextResult     = cryptoContext->MakeCoefPackedPlaintext(expected);
+    plaintextResult->SetLength(plaintextMulMany->GetLength());
+
+    EXPECT_EQ(*plaintextMulMany, *plaintextResult) << "EvalMultMany gives incorrect results for mixed depths.\n";
+}
@@ -194,6 +194,71 @@ TEST_F(UTBFVRNS_CRT, BFVrns_TestMultiplicativeDepthLimitation_HPSPOVERQLEVELED)
     }
 }
 
+// EvalMult and EvalMultMany go through the shared tensor product for every multiplication technique
+void BFVrns_TestEvalMultMany(MultiplicationTechnique multiplicationTechnique) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    const uint64_t ptm = 65537;
+
+    parameters.SetPlaintextModulus(ptm);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetMultiplicationTechnique(multiplicationTechnique);
+    parameters.SetSecurityLevel(SecurityLevel::HEStd_NotSet);
+    parameters.SetRingDim(32);
+
+    CryptoContext<DCRTPoly> cryptoContext = GenCryptoContext(parameters);
+    cryptoContext->Enable(PKE);
+    cryptoContext->Enable(KEYSWITCH);
+    cryptoContext->Enable(LEVELEDSHE);
+    cryptoContext->Enable(ADVANCEDSHE);
+
+    KeyPair<DCRTPoly> keyPair = cryptoContext->KeyGen();
+    cryptoContext->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<std::vector<int64_t>> inputs = {
+        {1, 2, 3, 4, 5, 6, 7, 8}, {3, 2, 1, 4, 5, 6, 7, 8}, {2, 2, 2, 2, 3, 3, 3, 3}, {1, -1, 1, -1, 1, -1, 1, -1}};
+    std::vector<Ciphertext<DCRTPoly>> ciphertexts;
+    for (const auto& input : inputs)
+        ciphertexts.push_back(cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(input)));
+
+    std::vector<int64_t> expectedMult(inputs[0].size());
+    std::vector<int64_t> expectedMany(inputs[0].size());
+    for (size_t i = 0; i < expectedMult.size(); ++i) {
+        expectedMult[i] = inputs[0][i] * inputs[1][i];
+        expectedMany[i] = expectedMult[i] * inputs[2][i] * inputs[3][i];
+    }
+
+    Plaintext result;
+    cryptoContext->Decrypt(keyPair.secretKey, cryptoContext->EvalMult(ciphertexts[0], ciphertexts[1]), &result);
+    result->SetLength(expectedMult.size());
+    EXPECT_EQ(result->GetPackedValue(), expectedMult) << "EvalMult fails for technique " << multiplicationTechnique;
+
+    cryptoContext->Decrypt(keyPair.secretKey, cryptoContext->EvalMultMany(ciphertexts), &result);
+    result->SetLength(expectedMany.size());
+    EXPECT_EQ(result->GetPackedValue(), expectedMany) << "EvalMultMany fails for technique " << multiplicationTechnique;
+
+    // a lazy product keeps its third element until EvalMultMany relinearizes it
+    cryptoContext->SetLazyRelinearization(true);
+    auto lazy = cryptoContext->EvalMult(ciphertexts[0], ciphertexts[1]);
+    EXPECT_EQ(lazy->GetElements().size(), 3U);
+    cryptoContext->Decrypt(keyPair.secretKey, lazy, &result);
+    result->SetLength(expectedMult.size());
+    EXPECT_EQ(result->GetPackedValue(), expectedMult)
+        << "Lazy EvalMult fails for technique " << multiplicationTechnique;
+
+    cryptoContext->Decrypt(keyPair.secretKey, cryptoContext->EvalMultMany({lazy, ciphertexts[2], ciphertexts[3]}),
+                           &result);
+    result->SetLength(expectedMany.size());
+    EXPECT_EQ(result->GetPackedValue(), expectedMany)
+        << "EvalMultMany of a lazy product fails for technique " << multiplicationTechnique;
+    cryptoContext->SetLazyRelinearization(false);
+}
+TEST_F(UTBFVRNS_CRT, BFVrns_EvalMultMany) {
+    BFVrns_TestEvalMultMany(BEHZ);
+    BFVrns_TestEvalMultMany(HPS);
+    BFVrns_TestEvalMultMany(HPSPOVERQ);
+    BFVrns_TestEvalMultMany(HPSPOVERQLEVELED);
+}
+
 TEST_F(UTBFVRNS_CRT, BFVrns_FastBaseConvqToBskMontgomery) {
     UnitTestCCParams parameters;
     parameters.schemeId                = BFVRNS_SCHEME;
@@ -55,6 +55,7 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_KEY_SWITCH,
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
+    BOOTSTRAP_LAZY,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -78,6 +79,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_NUM_TOWERS:
             typeName = "BOOTSTRAP_NUM_TOWERS";
             break;
+        case BOOTSTRAP_LAZY:
+            typeName = "BOOTSTRAP_LAZY";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -288,6 +292,12 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_NUM_TOWERS, "16", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
 #endif
     // ==========================================
+    // TestType,      Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_LAZY, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_LAZY, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+    { BOOTSTRAP_LAZY, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 },   8 },
+    { BOOTSTRAP_LAZY, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   8 },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -598,6 +608,70 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_Lazy(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            // only the parameters are stored; the linear maps are encoded on demand
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, 0, false);
+            size_t setupBytes = cc->GetMemoryUsage()["FHEPrecomputations"];
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input(
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots));
+            size_t encodedLength = input.size();
+
+            Plaintext plaintext1 = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext1     = cc->Encrypt(keyPair.publicKey, plaintext1);
+            plaintext1->SetLength(encodedLength);
+
+            // no cache budget: nothing is retained between calls
+            auto ciphertextAfter = cc->EvalBootstrap(ciphertext1);
+            EXPECT_EQ(setupBytes, cc->GetMemoryUsage()["FHEPrecomputations"]) << failmsg;
+
+            Plaintext result;
+            cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+            result->SetLength(encodedLength);
+            checkEquality(result->GetCKKSPackedValue(), plaintext1->GetCKKSPackedValue(), eps,
+                          failmsg + " Bootstrapping with lazily encoded linear maps fails");
+
+            // with a budget, the second call reuses the cached plaintexts
+            cc->SetBootstrapCacheBudget(size_t(1) << 32);
+            cc->EvalBootstrap(ciphertext1);
+            size_t cachedBytes = cc->GetMemoryUsage()["FHEPrecomputations"];
+            EXPECT_GT(cachedBytes, setupBytes) << failmsg;
+
+            ciphertextAfter = cc->EvalBootstrap(ciphertext1);
+            EXPECT_EQ(cachedBytes, cc->GetMemoryUsage()["FHEPrecomputations"]) << failmsg;
+            cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+            result->SetLength(encodedLength);
+            checkEquality(result->GetCKKSPackedValue(), plaintext1->GetCKKSPackedValue(), eps,
+                          failmsg + " Bootstrapping with cached linear maps fails");
+
+            // shrinking the budget evicts the cached plaintexts
+            cc->SetBootstrapCacheBudget(0);
+            EXPECT_EQ(setupBytes, cc->GetMemoryUsage()["FHEPrecomputations"]) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -626,6 +700,9 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_NUM_TOWERS:
             UnitTest_Bootstrap_NumTowers(test, test.buildTestName());
             break;
+        case BOOTSTRAP_LAZY:
+            UnitTest_Bootstrap_Lazy(test, test.buildTestName());
+            break;
         default:
             break;
     }
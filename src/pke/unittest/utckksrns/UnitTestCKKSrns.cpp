@@ -37,6 +37,9 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "UnitTestMetadataTest.h"
+#include "scheme/ckksrns/cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+#include "utils/opcounters.h"
 
 #include <iostream>
 #include <vector>
@@ -1513,6 +1516,27 @@ protected:
             results->SetLength(plaintextRight2->GetLength());
             checkEquality(plaintextRight2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
                           failmsg + " EvalFastRotation(-2) fails");
+
+            /* Testing EvalRotateMany {+2, -2, 0}
+             */
+            auto cResults = cc->EvalRotateMany(ciphertext1, {2, -2, 0});
+            cc->Decrypt(kp.secretKey, cResults[0], &results);
+            results->SetLength(plaintextLeft2->GetLength());
+            checkEquality(plaintextLeft2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(+2) fails");
+            cc->Decrypt(kp.secretKey, cResults[1], &results);
+            results->SetLength(plaintextRight2->GetLength());
+            checkEquality(plaintextRight2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(-2) fails");
+
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+            if (cryptoParams->GetKeySwitchTechnique() == HYBRID) {
+                cResults = cc->EvalRotateMany(ciphertext1, {2, 0}, true);
+                cc->Decrypt(kp.secretKey, cc->KeySwitchDown(cResults[0]), &results);
+                results->SetLength(plaintextLeft2->GetLength());
+                checkEquality(plaintextLeft2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                              failmsg + " EvalRotateMany(+2) in the extended basis fails");
+            }
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
@@ -2232,3 +2256,262 @@ TEST_P(UTCKKSRNS, CKKSRNS) {
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS, ::testing::ValuesIn(testCases), testName);
+
+TEST(UTCKKSRNS_BATCH, EncodeDecrypt) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+
+    std::vector<std::vector<double>> values(6);
+    for (size_t i = 0; i < values.size(); i++)
+        for (size_t j = 0; j < 8; j++)
+            values[i].push_back(0.1 * (i + 1) - 0.05 * j);
+
+    // a batch encodes to exactly the plaintexts encoded one at a time
+    auto plaintexts = cc->MakeCKKSPackedPlaintexts(values, 1, 1);
+    ASSERT_EQ(plaintexts.size(), values.size());
+    std::vector<Ciphertext<DCRTPoly>> ciphertexts;
+    for (size_t i = 0; i < values.size(); i++) {
+        auto single = cc->MakeCKKSPackedPlaintext(values[i], 1, 1);
+        EXPECT_TRUE(plaintexts[i]->GetElement<DCRTPoly>() == single->GetElement<DCRTPoly>())
+            << "Batch encoding of vector " << i << " differs";
+        ciphertexts.push_back(cc->Encrypt(keyPair.publicKey, plaintexts[i]));
+    }
+
+    std::vector<Plaintext> results;
+    auto decryptResults = cc->Decrypt(ciphertexts, keyPair.secretKey, &results);
+    ASSERT_EQ(results.size(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_TRUE(decryptResults[i].isValid);
+        results[i]->SetLength(values[i].size());
+        checkEquality(results[i]->GetRealPackedValue(), values[i], 0.0001, "Batch decryption fails");
+    }
+
+    // errors raised while encoding in parallel reach the caller
+    values[3].clear();
+    EXPECT_THROW(cc->MakeCKKSPackedPlaintexts(values), config_error);
+
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_PTXT_CACHE, EvalMultEvalAdd) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<double> x = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    std::vector<double> y = {1.0, -0.5, 0.25, 0.75, -1.0, 0.5, 0.125, -0.25};
+    std::vector<double> xxy, xxPlusY;
+    for (size_t i = 0; i < x.size(); i++) {
+        xxy.push_back(x[i] * x[i] * y[i]);
+        xxPlusY.push_back(x[i] * x[i] + y[i]);
+    }
+
+    auto ct   = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(x));
+    auto ctSq = cc->EvalMult(ct, ct);
+    auto ptY  = cc->MakeCKKSPackedPlaintext(y);
+
+    auto expected = cc->EvalMult(ctSq, ptY);
+    EXPECT_EQ(cc->GetMemoryUsage()["PlaintextCache"], 0U);
+
+    cc->SetPlaintextCacheBudget(size_t(1) << 26);
+    for (size_t i = 0; i < 3; i++) {
+        auto product = cc->EvalMult(ctSq, ptY);
+        EXPECT_EQ(product->GetLevel(), expected->GetLevel());
+        EXPECT_EQ(product->GetNoiseScaleDeg(), expected->GetNoiseScaleDeg());
+
+        Plaintext result;
+        cc->Decrypt(keyPair.secretKey, product, &result);
+        result->SetLength(x.size());
+        checkEquality(result->GetRealPackedValue(), xxy, 0.0001, "EvalMult with a cached plaintext fails");
+    }
+    // one re-encoding at level 1, reused by the later calls
+    size_t cached = cc->GetMemoryUsage()["PlaintextCache"];
+    EXPECT_GT(cached, 0U);
+
+    auto sum = cc->EvalAdd(cc->Rescale(ctSq), ptY);
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, sum, &result);
+    result->SetLength(x.size());
+    checkEquality(result->GetRealPackedValue(), xxPlusY, 0.0001, "EvalAdd with a cached plaintext fails");
+
+    // a small budget evicts, a zero budget clears
+    cc->SetPlaintextCacheBudget(cached);
+    EXPECT_LE(cc->GetMemoryUsage()["PlaintextCache"], cached);
+    cc->SetPlaintextCacheBudget(0);
+    EXPECT_EQ(cc->GetMemoryUsage()["PlaintextCache"], 0U);
+
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_LAZY_RELIN, SumOfProducts) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalRotateKeyGen(keyPair.secretKey, {1});
+
+    const size_t n = 4;
+    std::vector<std::vector<double>> x(n), y(n);
+    std::vector<double> sum(8, 0.0);
+    std::vector<Ciphertext<DCRTPoly>> ctX(n), ctY(n);
+    for (size_t k = 0; k < n; k++) {
+        for (size_t i = 0; i < 8; i++) {
+            x[k].push_back(0.1 * (i + 1) - 0.2 * k);
+            y[k].push_back(0.5 - 0.05 * (i + k));
+            sum[i] += x[k][i] * y[k][i];
+        }
+        ctX[k] = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(x[k]));
+        ctY[k] = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(y[k]));
+    }
+
+    auto sumOfProducts = [&]() {
+        auto result = cc->EvalMult(ctX[0], ctY[0]);
+        for (size_t k = 1; k < n; k++)
+            cc->EvalAddInPlace(result, cc->EvalMult(ctX[k], ctY[k]));
+        return result;
+    };
+
+    auto before           = OpCounters::GetSnapshot();
+    auto eager            = sumOfProducts();
+    auto eagerKeySwitches = (OpCounters::GetSnapshot() - before).GetCount(OPCOUNT_KEYSWITCH);
+
+    cc->SetLazyRelinearization(true);
+    EXPECT_TRUE(cc->GetLazyRelinearization());
+    before               = OpCounters::GetSnapshot();
+    auto lazy            = sumOfProducts();
+    auto lazyKeySwitches = (OpCounters::GetSnapshot() - before).GetCount(OPCOUNT_KEYSWITCH);
+
+    EXPECT_EQ(eager->GetElements().size(), 2U);
+    EXPECT_EQ(lazy->GetElements().size(), 3U);
+    EXPECT_EQ(lazyKeySwitches, 0U);
+    EXPECT_EQ(eagerKeySwitches, n);
+
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, lazy, &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), sum, 0.0001, "Decryption of an unrelinearized sum fails");
+
+    // a rotation relinearizes first
+    std::vector<double> rotated(sum.begin() + 1, sum.end());
+    rotated.push_back(sum[0]);
+    cc->Decrypt(keyPair.secretKey, cc->EvalRotate(lazy, 1), &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), rotated, 0.0001, "Rotation of an unrelinearized sum fails");
+
+    // so does the next multiplication
+    std::vector<double> squared;
+    for (auto v : sum)
+        squared.push_back(v * v);
+    auto product = cc->EvalMult(lazy, lazy);
+    EXPECT_EQ(product->GetElements().size(), 3U);
+    cc->Decrypt(keyPair.secretKey, product, &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), squared, 0.0001, "Product of unrelinearized sums fails");
+
+    cc->SetLazyRelinearization(false);
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_LAZY_RELIN, EntryPoints) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(5);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalSumKeyGen(keyPair.secretKey);
+
+    std::vector<double> x = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    std::vector<double> y = {0.8, -0.7, 0.6, -0.5, 0.4, -0.3, 0.2, -0.1};
+    auto ctX              = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(x));
+    auto ctY              = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(y));
+
+    std::vector<double> xy;
+    double total = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        xy.push_back(x[i] * y[i]);
+        total += xy[i];
+    }
+
+    cc->SetLazyRelinearization(true);
+    auto lazy = cc->EvalMult(ctX, ctY);
+    ASSERT_EQ(lazy->GetElements().size(), 3U);
+
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, cc->EvalSum(lazy, 8), &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), std::vector<double>(8, total), 0.0001,
+                  "EvalSum of an unrelinearized product fails");
+
+    double dot = 0;
+    for (auto v : xy)
+        dot += v * v;
+    cc->Decrypt(keyPair.secretKey, cc->EvalInnerProduct(lazy, lazy, 8), &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), std::vector<double>(8, dot), 0.0001,
+                  "EvalInnerProduct of unrelinearized products fails");
+
+    std::vector<double> squared;
+    for (auto v : xy)
+        squared.push_back(v * v);
+    auto lhs = lazy->Clone();
+    auto rhs = cc->EvalMult(ctX, ctY);
+    cc->Decrypt(keyPair.secretKey, cc->EvalMultMutable(lhs, rhs), &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), squared, 0.0001, "EvalMultMutable of unrelinearized products fails");
+
+    // 0.5 + t + 0.25 t^2
+    std::vector<double> poly;
+    for (auto v : xy)
+        poly.push_back(0.5 + v + 0.25 * v * v);
+    cc->Decrypt(keyPair.secretKey, cc->EvalPoly(lazy, {0.5, 1.0, 0.25}), &result);
+    result->SetLength(8);
+    checkEquality(result->GetRealPackedValue(), poly, 0.0001, "EvalPoly of an unrelinearized product fails");
+
+    cc->SetLazyRelinearization(false);
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
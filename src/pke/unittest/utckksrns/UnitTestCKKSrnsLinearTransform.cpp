@@ -0,0 +1,177 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Unit tests for the plaintext matrix - encrypted vector and encrypted matrix - encrypted matrix products
+ */
+
+#include "scheme/ckksrns/cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include "UnitTestUtils.h"
+
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace lbcrypto;
+
+static CryptoContext<DCRTPoly> MakeCKKSrnsLinearTransformCC(ScalingTechnique scalTech) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(64);
+    parameters.SetBatchSize(32);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetScalingTechnique(scalTech);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    return cc;
+}
+
+static void RunLinearTransformTest(ScalingTechnique scalTech) {
+    auto cc = MakeCKKSrnsLinearTransformCC(scalTech);
+
+    // a 5 x 7 matrix is padded to dimension 8 and applied to 32 slots
+    const uint32_t rows = 5, cols = 7;
+    std::vector<std::vector<double>> A(rows, std::vector<double>(cols));
+    for (uint32_t i = 0; i < rows; i++) {
+        for (uint32_t j = 0; j < cols; j++)
+            A[i][j] = static_cast<double>((3 * i + 5 * j) % 7) - 3;
+    }
+    std::vector<double> x(cols);
+    for (uint32_t j = 0; j < cols; j++)
+        x[j] = 0.25 * j - 1;
+
+    std::vector<std::complex<double>> expected(32);
+    for (uint32_t i = 0; i < rows; i++) {
+        for (uint32_t j = 0; j < cols; j++)
+            expected[i] += A[i][j] * x[j];
+    }
+
+    auto precom = cc->EvalLinearTransformPrecompute(A);
+    EXPECT_EQ(precom->GetDimension(), 8u);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalRotateKeyGen(keyPair.secretKey, precom->GetRotationIndices());
+
+    auto ct = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(x));
+
+    // the second call is served from the cache of encoded diagonals
+    for (int iteration = 0; iteration < 2; iteration++) {
+        auto result = cc->EvalLinearTransform(precom, ct);
+
+        Plaintext plaintext;
+        cc->Decrypt(keyPair.secretKey, result, &plaintext);
+        plaintext->SetLength(expected.size());
+        checkEquality(expected, plaintext->GetCKKSPackedValue(), 0.001, "EvalLinearTransform fails");
+    }
+}
+
+static void RunMatMulTest(ScalingTechnique scalTech) {
+    auto cc = MakeCKKSrnsLinearTransformCC(scalTech);
+
+    // 4 x 4 matrices packed row by row into the first 16 of 32 slots
+    const uint32_t d = 4;
+    std::vector<double> a(d * d), b(d * d);
+    for (uint32_t i = 0; i < d * d; i++) {
+        a[i] = static_cast<double>(i % 5) - 2;
+        b[i] = 0.5 * static_cast<double>((7 * i) % 4);
+    }
+
+    std::vector<std::complex<double>> expected(32);
+    for (uint32_t i = 0; i < d; i++) {
+        for (uint32_t j = 0; j < d; j++) {
+            for (uint32_t k = 0; k < d; k++)
+                expected[i * d + j] += a[i * d + k] * b[k * d + j];
+        }
+    }
+
+    auto precom = cc->EvalMatMulPrecompute(d);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalRotateKeyGen(keyPair.secretKey, precom->GetRotationIndices());
+
+    auto ctA    = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(a));
+    auto ctB    = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(b));
+    auto result = cc->EvalMatMul(precom, ctA, ctB);
+
+    Plaintext plaintext;
+    cc->Decrypt(keyPair.secretKey, result, &plaintext);
+    plaintext->SetLength(expected.size());
+    checkEquality(expected, plaintext->GetCKKSPackedValue(), 0.001, "EvalMatMul fails");
+}
+
+TEST(UTCKKSRNS_LINEAR_TRANSFORM, EvalLinearTransform_FLEXIBLEAUTO) {
+    RunLinearTransformTest(FLEXIBLEAUTO);
+}
+
+TEST(UTCKKSRNS_LINEAR_TRANSFORM, EvalLinearTransform_FIXEDMANUAL) {
+    RunLinearTransformTest(FIXEDMANUAL);
+}
+
+TEST(UTCKKSRNS_LINEAR_TRANSFORM, EvalMatMul_FLEXIBLEAUTO) {
+    RunMatMulTest(FLEXIBLEAUTO);
+}
+
+TEST(UTCKKSRNS_LINEAR_TRANSFORM, EvalMatMul_FIXEDMANUAL) {
+    RunMatMulTest(FIXEDMANUAL);
+}
+
+TEST(UTCKKSRNS_LINEAR_TRANSFORM, DiagonalInput) {
+    auto cc = MakeCKKSrnsLinearTransformCC(FLEXIBLEAUTO);
+
+    // a cyclic shift of 32 entries given by its single diagonal
+    auto precom = cc->EvalLinearTransformPrecompute(32, {{3, std::vector<double>(32, 2.0)}});
+    EXPECT_EQ(precom->GetDiagonalIndices().size(), 1u);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalRotateKeyGen(keyPair.secretKey, precom->GetRotationIndices());
+
+    std::vector<double> x(32);
+    std::vector<std::complex<double>> expected(32);
+    for (uint32_t i = 0; i < 32; i++)
+        x[i] = 0.1 * i;
+    for (uint32_t i = 0; i < 32; i++)
+        expected[i] = 2.0 * x[(i + 3) % 32];
+
+    auto ct     = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(x));
+    auto result = cc->EvalLinearTransform(precom, ct);
+
+    Plaintext plaintext;
+    cc->Decrypt(keyPair.secretKey, result, &plaintext);
+    plaintext->SetLength(expected.size());
+    checkEquality(expected, plaintext->GetCKKSPackedValue(), 0.001, "EvalLinearTransform with diagonal input fails");
+}
@@ -34,6 +34,8 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -41,7 +43,10 @@
 
 #include "ciphertext-ser.h"
 #include "cryptocontext-ser.h"
+#include "key/key-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
+#include "scheme/ckksrns/cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
 #include "globals.h"  // for SERIALIZE_PRECOMPUTE
 #include "utils/demangle.h"
 
@@ -214,12 +219,43 @@ protected:
 
                 ASSERT_TRUE(cc) << "Deser failed";
                 ASSERT_TRUE(CryptoContextFactory<DCRTPoly>::GetContextCount() == 1);
+
+                // another copy resolves to the registered context
+                std::stringstream s2;
+                Serial::Serialize(cc, s2, sertype);
+                std::string ser = s2.str();
+                CryptoContext<Element> cc2;
+                std::stringstream s3(ser);
+                Serial::Deserialize(cc2, s3, sertype);
+                EXPECT_EQ(cc, cc2) << "Deserialized context was not found in the registry";
+
+                EXPECT_TRUE(CryptoContextFactory<DCRTPoly>::ReleaseContext(cc));
+                EXPECT_FALSE(CryptoContextFactory<DCRTPoly>::ReleaseContext(cc));
+                ASSERT_TRUE(CryptoContextFactory<DCRTPoly>::GetContextCount() == 0);
+                std::stringstream s4(ser);
+                Serial::Deserialize(cc, s4, sertype);
+                ASSERT_TRUE(CryptoContextFactory<DCRTPoly>::GetContextCount() == 1);
             }
 
             DisablePrecomputeCRTTablesAfterDeserializaton();
             KeyPair<DCRTPoly> kp = cc->KeyGen();
             KeyPair<DCRTPoly> kpnew;
 
+            OPENFHE_DEBUG("step 0a");
+            {
+                // a registered context whose batch size changes still binds deserialized objects
+                usint batchSize = cc->GetEncodingParams()->GetBatchSize();
+                cc->GetEncodingParams()->SetBatchSize(batchSize / 2);
+
+                std::stringstream s;
+                Serial::Serialize(kp.publicKey, s, sertype);
+                Serial::Deserialize(kpnew.publicKey, s, sertype);
+                EXPECT_EQ(kpnew.publicKey->GetCryptoContext(), cc) << "Deserialized key bound to another context";
+                EXPECT_EQ(CryptoContextFactory<DCRTPoly>::GetContextCount(), 1) << "Context registered twice";
+
+                cc->GetEncodingParams()->SetBatchSize(batchSize);
+            }
+
             OPENFHE_DEBUG("step 1");
             {
                 std::stringstream s;
@@ -486,3 +522,510 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);
+
+//===========================================================================================================
+static CryptoContext<DCRTPoly> MakeCKKSrnsBootstrapCC(uint32_t ringDim) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecretKeyDist(UNIFORM_TERNARY);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(ringDim);
+#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
+    parameters.SetScalingModSize(78);
+    parameters.SetFirstModSize(89);
+#else
+    parameters.SetScalingModSize(59);
+    parameters.SetFirstModSize(60);
+#endif
+    parameters.SetScalingTechnique(FIXEDAUTO);
+    parameters.SetMultiplicativeDepth(25);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+    cc->Enable(FHE);
+
+    return cc;
+}
+
+template <typename ST>
+static void TestBootstrapPrecomSer(const ST& sertype, const std::vector<uint32_t>& levelBudget,
+                                   const std::string& failmsg) {
+    const uint32_t slots = 8;
+
+    std::stringstream s;
+    {
+        auto cc = MakeCKKSrnsBootstrapCC(512);
+        cc->EvalBootstrapSetup(levelBudget, {0, 0}, slots);
+        ASSERT_TRUE(cc->SerializeBootstrapPrecom(s, sertype, slots)) << failmsg;
+    }
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+    // a context with the same parameters loads the precomputation instead of running EvalBootstrapSetup
+    auto cc = MakeCKKSrnsBootstrapCC(512);
+    std::string serialized = s.str();
+    ASSERT_TRUE(cc->DeserializeBootstrapPrecom(s, sertype)) << failmsg;
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalBootstrapKeyGen(keyPair.secretKey, slots);
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<std::complex<double>> input = {0.111111, 0.222222, 0.333333, 0.444444,
+                                               0.555555, 0.666666, 0.777777, 0.888888};
+    Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, 24, nullptr, slots);
+    auto ciphertext     = cc->EvalBootstrap(cc->Encrypt(keyPair.publicKey, plaintext));
+
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, ciphertext, &result);
+    result->SetLength(input.size());
+    checkEquality(result->GetCKKSPackedValue(), input, 0.0001, failmsg + " Bootstrapping after deserialization fails");
+
+    // the precomputation is rejected by a context with a different ring dimension
+    auto otherCC = MakeCKKSrnsBootstrapCC(1024);
+    std::stringstream other(serialized);
+    EXPECT_THROW(otherCC->DeserializeBootstrapPrecom(other, sertype), config_error) << failmsg;
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_SER_BOOT, BootstrapPrecom) {
+    // linear method and FFT-like method
+    for (const auto& levelBudget : std::vector<std::vector<uint32_t>>{{1, 1}, {2, 2}}) {
+        TestBootstrapPrecomSer(SerType::JSON, levelBudget, "json");
+        TestBootstrapPrecomSer(SerType::BINARY, levelBudget, "binary");
+    }
+}
+
+//===========================================================================================================
+template <typename ST>
+static void TestEvalKeyStore(const ST& sertype, const std::string& failmsg) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(1);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    const std::vector<int32_t> indices = {1, 2, 3, -1};
+    auto keyPair                       = cc->KeyGen();
+    cc->EvalRotateKeyGen(keyPair.secretKey, indices);
+
+    const auto keyTag = keyPair.secretKey->GetKeyTag();
+    const auto dir    = std::filesystem::temp_directory_path() / ("openfhe_keystore_" + keyTag.substr(0, 16));
+    std::filesystem::create_directories(dir);
+
+    const auto& keyMap = cc->GetEvalAutomorphismKeyMap(keyTag);
+    size_t keyBytes    = keyMap.begin()->second->GetMemoryUsage();
+    ASSERT_TRUE((EvalKeyDirectoryStore<DCRTPoly, ST>::WriteEvalAutomorphismKeys(dir.string(), keyMap, sertype)))
+        << failmsg;
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+    // room for two keys
+    CryptoContextImpl<DCRTPoly>::SetEvalKeyStore(
+        std::make_shared<EvalKeyDirectoryStore<DCRTPoly, ST>>(dir.string(), sertype), 2 * keyBytes);
+
+    std::vector<double> input = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    auto ciphertext           = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+    auto rotated              = [&](int32_t index) {
+        std::vector<double> expected(input.size());
+        for (size_t i = 0; i < input.size(); i++)
+            expected[i] = input[(i + input.size() + index) % input.size()];
+        return expected;
+    };
+
+    Plaintext result;
+    for (auto index : indices) {
+        cc->Decrypt(keyPair.secretKey, cc->EvalRotate(ciphertext, index), &result);
+        result->SetLength(input.size());
+        checkEquality(result->GetRealPackedValue(), rotated(index), 0.0001,
+                      failmsg + " Rotation by " + std::to_string(index) + " with a key from the store fails");
+        EXPECT_LE(cc->GetEvalAutomorphismKeyMap(keyTag).size(), 2u) << failmsg << " Keys are not evicted";
+    }
+
+    // the keys of a single operation are kept even beyond the budget
+    auto rotations = cc->EvalRotateMany(ciphertext, indices);
+    EXPECT_EQ(cc->GetEvalAutomorphismKeyMap(keyTag).size(), indices.size()) << failmsg;
+    for (size_t i = 0; i < indices.size(); i++) {
+        cc->Decrypt(keyPair.secretKey, rotations[i], &result);
+        result->SetLength(input.size());
+        checkEquality(result->GetRealPackedValue(), rotated(indices[i]), 0.0001, failmsg + " EvalRotateMany fails");
+    }
+
+    // without a store, missing keys are reported as before
+    CryptoContextImpl<DCRTPoly>::SetEvalKeyStore(nullptr);
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+    EXPECT_THROW(cc->EvalRotate(ciphertext, 1), not_available_error) << failmsg;
+
+    std::filesystem::remove_all(dir);
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_SER_KEYSTORE, LazyRotationKeys) {
+    TestEvalKeyStore(SerType::JSON, "json");
+    TestEvalKeyStore(SerType::BINARY, "binary");
+}
+
+//===========================================================================================================
+// grows the seed of a binary archive by one word, as a crafted file could; empty if the seed is not found
+static std::string OversizeSeed(const std::string& ser, const PRNGSeed& seed) {
+    uint64_t size = seed.size();
+    std::string pattern(sizeof(size) + sizeof(seed), '\0');
+    std::memcpy(&pattern[0], &size, sizeof(size));
+    std::memcpy(&pattern[sizeof(size)], seed.data(), sizeof(seed));
+    auto pos = ser.find(pattern);
+    if (pos == std::string::npos)
+        return std::string();
+
+    std::string result = ser;
+    size++;
+    std::memcpy(&result[pos], &size, sizeof(size));
+    result.insert(pos + pattern.size(), sizeof(uint32_t), '\x01');
+    return result;
+}
+
+TEST(UTCKKSRNS_SER_SEEDED, EvalKey) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetKeySwitchTechnique(HYBRID);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    auto evalKey = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(
+        cc->GetEvalMultKeyVector(keyPair.secretKey->GetKeyTag()).at(0));
+    ASSERT_TRUE(evalKey != nullptr && evalKey->HasASeed());
+
+    // the same key with vector a stored explicitly
+    auto fullKey = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(cc);
+    fullKey->SetKeyTag(evalKey->GetKeyTag());
+    fullKey->SetAVector(evalKey->GetAVector());
+    fullKey->SetBVector(evalKey->GetBVector());
+    ASSERT_FALSE(fullKey->HasASeed());
+
+    std::stringstream seeded, full;
+    Serial::Serialize(std::static_pointer_cast<EvalKeyImpl<DCRTPoly>>(evalKey), seeded, SerType::BINARY);
+    Serial::Serialize(std::static_pointer_cast<EvalKeyImpl<DCRTPoly>>(fullKey), full, SerType::BINARY);
+    EXPECT_LT(seeded.str().size(), full.str().size() * 6 / 10) << "Seeded key is not compressed";
+
+    // vector a is expanded to the original on load
+    EvalKey<DCRTPoly> loaded;
+    Serial::Deserialize(loaded, seeded, SerType::BINARY);
+    EXPECT_TRUE(*loaded == *evalKey) << "Seeded key does not expand to the original";
+    EXPECT_TRUE(std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(loaded)->HasASeed());
+
+    EvalKey<DCRTPoly> loadedFull;
+    Serial::Deserialize(loadedFull, full, SerType::BINARY);
+    EXPECT_TRUE(*loadedFull == *evalKey) << "Unseeded key does not round trip";
+
+    // a seed longer than a PRNGSeed is rejected
+    std::string oversized = OversizeSeed(seeded.str(), evalKey->GetASeed());
+    ASSERT_FALSE(oversized.empty()) << "Seed not found in the serialized key";
+    std::stringstream crafted(oversized);
+    EvalKey<DCRTPoly> rejected;
+    EXPECT_THROW(Serial::Deserialize(rejected, crafted, SerType::BINARY), deserialize_error);
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_SER_SEEDED, Ciphertext) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair              = cc->KeyGen();
+    std::vector<double> input = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    Plaintext plaintext       = cc->MakeCKKSPackedPlaintext(input);
+
+    // secret-key encryption produces a ciphertext serialized as a seed and its first element
+    auto seededCiphertext = cc->Encrypt(keyPair.secretKey, plaintext);
+    auto fullCiphertext   = cc->Encrypt(keyPair.publicKey, plaintext);
+    ASSERT_TRUE(seededCiphertext->HasElementSeed());
+    ASSERT_FALSE(fullCiphertext->HasElementSeed());
+
+    std::stringstream seeded, full;
+    Serial::Serialize(seededCiphertext, seeded, SerType::BINARY);
+    Serial::Serialize(fullCiphertext, full, SerType::BINARY);
+    EXPECT_LT(seeded.str().size(), full.str().size() * 6 / 10) << "Seeded ciphertext is not compressed";
+
+    Ciphertext<DCRTPoly> loaded;
+    Serial::Deserialize(loaded, seeded, SerType::BINARY);
+    EXPECT_TRUE(*loaded == *seededCiphertext) << "Seeded ciphertext does not expand to the original";
+
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, loaded, &result);
+    result->SetLength(input.size());
+    checkEquality(result->GetRealPackedValue(), input, 0.0001, "Decryption of a seeded ciphertext fails");
+
+    // computed ciphertexts are serialized in full
+    auto sum = cc->EvalAdd(loaded, loaded);
+    EXPECT_FALSE(sum->HasElementSeed());
+
+    // a seed longer than a PRNGSeed is rejected
+    PRNGSeed seed;
+    seed.fill(0x5a5a5a5a);
+    auto craftedCiphertext = cc->Encrypt(keyPair.secretKey, plaintext);
+    craftedCiphertext->SetElementSeed(seed);
+    std::stringstream craftedSer;
+    Serial::Serialize(craftedCiphertext, craftedSer, SerType::BINARY);
+    std::string oversized = OversizeSeed(craftedSer.str(), seed);
+    ASSERT_FALSE(oversized.empty()) << "Seed not found in the serialized ciphertext";
+    std::stringstream crafted(oversized);
+    Ciphertext<DCRTPoly> rejected;
+    EXPECT_THROW(Serial::Deserialize(rejected, crafted, SerType::BINARY), deserialize_error);
+
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+//===========================================================================================================
+TEST(UTCKKSRNS_SER_FLAT, Ciphertext) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<double> input = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    std::vector<double> squared;
+    for (auto v : input)
+        squared.push_back(v * v);
+
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+    // a rescaled product has fewer towers than the parameters of the context
+    auto product = cc->Rescale(cc->EvalMult(ciphertext, ciphertext));
+
+    for (const auto& original : {ciphertext, product}) {
+        std::stringstream flat, binary;
+        cc->SerializeFlat(original, flat);
+        Serial::Serialize(original, binary, SerType::BINARY);
+        EXPECT_LT(flat.str().size(), binary.str().size()) << "Flat ciphertext is larger than the binary one";
+
+        auto loaded = cc->DeserializeCiphertextFlat(flat);
+        EXPECT_TRUE(*loaded == *original) << "Flat ciphertext does not round trip";
+        EXPECT_EQ(loaded->GetLevel(), original->GetLevel());
+        EXPECT_EQ(loaded->GetElements()[0].GetNumOfElements(), original->GetElements()[0].GetNumOfElements());
+    }
+
+    std::stringstream flat;
+    cc->SerializeFlat(product, flat);
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, cc->DeserializeCiphertextFlat(flat), &result);
+    result->SetLength(input.size());
+    checkEquality(result->GetRealPackedValue(), squared, 0.0001, "Decryption of a flat ciphertext fails");
+
+    // the stream is checked before anything is read into the ciphertext
+    std::stringstream binary;
+    Serial::Serialize(product, binary, SerType::BINARY);
+    EXPECT_THROW(cc->DeserializeCiphertextFlat(binary), deserialize_error);
+
+    // sizes and coefficients are validated before they are used
+    const std::string valid    = flat.str();
+    const size_t tagSize       = product->GetKeyTag().size();
+    const size_t elementOffset = 56 + (tagSize + 7) / 8 * 8;
+    const size_t towers        = product->GetElements()[0].GetNumOfElements();
+
+    auto rejects = [&](size_t offset, uint64_t value, size_t width) {
+        std::string tampered = valid;
+        std::memcpy(&tampered[offset], &value, width);
+        std::stringstream crafted(tampered);
+        EXPECT_THROW(cc->DeserializeCiphertextFlat(crafted), deserialize_error) << "offset " << offset;
+    };
+    rejects(8, 1000000, sizeof(uint32_t));                                     // element count
+    rejects(48, uint64_t(1) << 40, sizeof(uint64_t));                          // key tag length
+    rejects(elementOffset + 12, 0, sizeof(uint32_t));                          // tower count
+    rejects(elementOffset + 24 + 8 * towers, ~uint64_t(0), sizeof(uint64_t));  // first coefficient
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_SER_FLAT, EvalKey) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetKeySwitchTechnique(HYBRID);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    auto evalKey = cc->GetEvalMultKeyVector(keyPair.secretKey->GetKeyTag()).at(0);
+
+    // the same key with vector a stored explicitly
+    auto relinKey = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(evalKey);
+    auto fullKey  = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(cc);
+    fullKey->SetKeyTag(relinKey->GetKeyTag());
+    fullKey->SetAVector(relinKey->GetAVector());
+    fullKey->SetBVector(relinKey->GetBVector());
+
+    std::stringstream seeded, full;
+    cc->SerializeFlat(evalKey, seeded);
+    cc->SerializeFlat(fullKey, full);
+    EXPECT_LT(seeded.str().size(), full.str().size() * 6 / 10) << "Seeded flat key is not compressed";
+
+    auto loaded = cc->DeserializeEvalKeyFlat(seeded);
+    EXPECT_TRUE(*loaded == *evalKey) << "Seeded flat key does not expand to the original";
+    EXPECT_TRUE(std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(loaded)->HasASeed());
+    EXPECT_TRUE(*cc->DeserializeEvalKeyFlat(full) == *evalKey) << "Unseeded flat key does not round trip";
+
+    // the digit count is validated before anything is allocated
+    std::string tampered = full.str();
+    const uint32_t count = 0xffffffff;
+    std::memcpy(&tampered[8], &count, sizeof(count));
+    std::stringstream crafted(tampered);
+    EXPECT_THROW(cc->DeserializeEvalKeyFlat(crafted), deserialize_error);
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_SER_FLAT, Compressed) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(40);
+    parameters.SetFirstModSize(60);
+    parameters.SetBatchSize(8);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<double> input = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    std::vector<double> squared;
+    for (auto v : input)
+        squared.push_back(v * v);
+
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+    auto product    = cc->EvalMult(ciphertext, ciphertext);
+
+    std::stringstream flat, packed, trimmed;
+    cc->SerializeFlat(product, flat);
+    cc->SerializeCompressed(product, packed);
+    cc->SerializeCompressed(product, trimmed, 1);
+    // 60- and 40-bit towers packed instead of 64-bit words
+    EXPECT_LT(packed.str().size(), flat.str().size() * 8 / 10) << "Bit packing does not reduce the size";
+    EXPECT_LT(trimmed.str().size(), flat.str().size() / 3) << "Dropping towers does not reduce the size";
+
+    auto loaded = cc->DeserializeCiphertextFlat(packed);
+    EXPECT_TRUE(*loaded == *product) << "Bit-packed ciphertext does not round trip";
+
+    auto loadedTrimmed = cc->DeserializeCiphertextFlat(trimmed);
+    EXPECT_EQ(loadedTrimmed->GetElements()[0].GetNumOfElements(), 1U);
+    EXPECT_TRUE(*loadedTrimmed == *cc->Compress(product, 1)) << "Compressed ciphertext does not round trip";
+
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, loadedTrimmed, &result);
+    result->SetLength(input.size());
+    checkEquality(result->GetRealPackedValue(), squared, 0.0001, "Decryption of a compressed ciphertext fails");
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+TEST(UTCKKSRNS_SER_FLAT, KeyBundle) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(512);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keyPair      = cc->KeyGen();
+    const auto keyTag = keyPair.secretKey->GetKeyTag();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalRotateKeyGen(keyPair.secretKey, {1, 2, -1});
+
+    const auto multKeys = cc->GetEvalMultKeyVector(keyTag);
+    const auto autoKeys = cc->GetEvalAutomorphismKeyMap(keyTag);
+
+    std::stringstream multBundle, autoBundle;
+    EXPECT_TRUE(cc->SerializeEvalMultKeyFlat(multBundle, keyTag));
+    EXPECT_TRUE(cc->SerializeEvalAutomorphismKeyFlat(autoBundle, keyTag));
+    EXPECT_FALSE(cc->SerializeEvalAutomorphismKeyFlat(autoBundle, "missing"));
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+    EXPECT_EQ(cc->DeserializeEvalMultKeyFlat(multBundle), multKeys.size());
+    EXPECT_TRUE(*cc->GetEvalMultKeyVector(keyTag).at(0) == *multKeys.at(0)) << "EvalMult key does not round trip";
+
+    // a record claiming more bytes than the stream holds fails at the end of the stream
+    std::string tampered       = multBundle.str();
+    const size_t sizeOffset    = 24 + (keyTag.size() + 7) / 8 * 8 + 8;
+    const uint64_t claimedSize = uint64_t(1) << 40;
+    std::memcpy(&tampered[sizeOffset], &claimedSize, sizeof(claimedSize));
+    std::stringstream crafted(tampered);
+    EXPECT_THROW(cc->DeserializeEvalMultKeyFlat(crafted), deserialize_error);
+
+    // keep all keys but the one for rotations by 2
+    const usint skipped = FindAutomorphismIndex2nComplex(2, cc->GetCyclotomicOrder());
+    EXPECT_EQ(cc->DeserializeEvalAutomorphismKeyFlat(autoBundle, [&](usint index) { return index != skipped; }),
+              autoKeys.size() - 1);
+    const auto& loaded = cc->GetEvalAutomorphismKeyMap(keyTag);
+    EXPECT_EQ(loaded.size(), autoKeys.size() - 1);
+    EXPECT_EQ(loaded.count(skipped), 0U);
+    for (const auto& key : loaded)
+        EXPECT_TRUE(*key.second == *autoKeys.at(key.first)) << "Automorphism key does not round trip";
+
+    std::vector<double> input = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    auto ciphertext           = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+    Plaintext result;
+    cc->Decrypt(keyPair.secretKey, cc->EvalRotate(ciphertext, 1), &result);
+    result->SetLength(input.size());
+    std::vector<double> rotated(input.begin() + 1, input.end());
+    rotated.push_back(0.1);
+    checkEquality(result->GetRealPackedValue(), rotated, 0.0001, "Rotation with loaded keys fails");
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}